@@ -151,4 +151,504 @@
      ASSERT_GE(output[i], -128);
      ASSERT_LE(output[i], 127);
    }
+ }
+
+ // Testcase2: ConvDwInt8SW with 5x5/7x7 kernels at stride 1 and 2, "same" padding
+ // Input: 1x9x9x16 (two 8-channel blocks). These are the shapes a register-blocked generic
+ // depthwise engine is selected for, so the sliding-window result is pinned bit-exactly
+ // against a scalar reference here.
+ TEST_F(ConvDwInt8Test, ConvDwInt8SW_LargeKernel_Stride1_Stride2) {
+   const int in_h = 9;
+   const int in_w = 9;
+   const int channel = 16;
+   const int c_block = UP_DIV(channel, C8NUM);
+
+   // Input: 1x9x9x16 (NHWC8 format, channel already a multiple of 8)
+   std::vector<int8_t> input(in_h * in_w * channel);
+   for (size_t i = 0; i < input.size(); i++) {
+     input[i] = static_cast<int8_t>(static_cast<int>(i * 37 % 101) - 50);
+   }
+
+   // Per-channel quantization, broadcast to every channel like the kernel's ReinitQuantParam does
+   std::vector<int32_t> bias(channel);
+   std::vector<int8_t> input_zp(channel, 0);
+   std::vector<int32_t> output_zp(channel);
+   std::vector<int32_t> quant_multiplier(channel);
+   std::vector<int32_t> left_shift(channel, 0);
+   std::vector<int32_t> right_shift(channel);
+   std::vector<int32_t> out_act_min(channel, -128);
+   std::vector<int32_t> out_act_max(channel, 127);
+   for (int c = 0; c < channel; c++) {
+     bias[c] = (c % 5 - 2) * 40;
+     output_zp[c] = c % 3 - 1;
+     quant_multiplier[c] = (c % 2 == 0) ? 1073741824 : 1610612736;
+     right_shift[c] = -7 - c % 2;
+   }
+   QuantArg input_quant_args[1] = {{1.0f, 0}};
+   QuantArg output_quant_args[1] = {{1.0f, 0}};
+
+   auto run_case = [&](int kernel, int stride) {
+     const int pad = kernel / 2;
+     const int out_h = (in_h + 2 * pad - kernel) / stride + 1;
+     const int out_w = (in_w + 2 * pad - kernel) / stride + 1;
+
+     // Weight: [c_block][kernel_h][kernel_w][8] (int16, filter zero point already subtracted)
+     std::vector<int16_t> weight(c_block * kernel * kernel * C8NUM);
+     for (size_t i = 0; i < weight.size(); i++) {
+       weight[i] = static_cast<int16_t>(static_cast<int>(i * 13 % 19) - 9);
+     }
+
+     ConvParameter conv_param;
+     memset(&conv_param, 0, sizeof(ConvParameter));
+     conv_param.kernel_h_ = kernel;
+     conv_param.kernel_w_ = kernel;
+     conv_param.stride_h_ = stride;
+     conv_param.stride_w_ = stride;
+     conv_param.dilation_h_ = 1;
+     conv_param.dilation_w_ = 1;
+     conv_param.pad_u_ = pad;
+     conv_param.pad_d_ = pad;
+     conv_param.pad_l_ = pad;
+     conv_param.pad_r_ = pad;
+     conv_param.input_batch_ = 1;
+     conv_param.input_h_ = in_h;
+     conv_param.input_w_ = in_w;
+     conv_param.input_channel_ = channel;
+     conv_param.output_batch_ = 1;
+     conv_param.output_h_ = out_h;
+     conv_param.output_w_ = out_w;
+     conv_param.output_channel_ = channel;
+     conv_param.thread_num_ = 1;
+     conv_param.conv_quant_arg_.input_quant_args_ = input_quant_args;
+     conv_param.conv_quant_arg_.output_quant_args_ = output_quant_args;
+     conv_param.conv_quant_arg_.quant_multiplier_ = quant_multiplier.data();
+     conv_param.conv_quant_arg_.left_shift_ = left_shift.data();
+     conv_param.conv_quant_arg_.right_shift_ = right_shift.data();
+     conv_param.conv_quant_arg_.out_act_min_ = out_act_min.data();
+     conv_param.conv_quant_arg_.out_act_max_ = out_act_max.data();
+     conv_param.conv_quant_arg_.per_channel_ = FILTER_PER_CHANNEL;
+
+     // Sliding window parameters, same derivation as InitSlidingParamConvDw
+     SlidingWindowParam sliding;
+     memset(&sliding, 0, sizeof(SlidingWindowParam));
+     int left = 0;
+     while (left * stride < pad) left++;
+     int right = out_w;
+     while ((right - 1) * stride - pad + kernel > in_w) right--;
+     int top = 0;
+     while (top * stride < pad) top++;
+     int bottom = out_h;
+     while ((bottom - 1) * stride - pad + kernel > in_h) bottom--;
+     sliding.left_ = left;
+     sliding.right_ = right;
+     sliding.top_ = top;
+     sliding.bottom_ = bottom;
+     sliding.c_block_ = c_block;
+     sliding.block_channel_ = c_block * C8NUM;
+     sliding.out_step_ = out_h * out_w * sliding.block_channel_;
+     sliding.out_h_step_ = out_w * sliding.block_channel_;
+     sliding.in_step_ = in_h * in_w * sliding.block_channel_;
+     sliding.in_h_step_ = in_w * sliding.block_channel_;
+     sliding.in_sh_step_ = sliding.in_h_step_ * stride;
+     sliding.in_sw_step_ = sliding.block_channel_ * stride;
+     sliding.in_kh_step_ = sliding.in_h_step_;
+     sliding.in_kw_step_ = sliding.block_channel_;
+     sliding.kernel_step_ = kernel * kernel * C8NUM;
+
+     // Scalar reference: padded taps are skipped, as in DepthwiseBorderPixelInt8
+     std::vector<int8_t> benchmark(out_h * out_w * channel, 0);
+     for (int oh = 0; oh < out_h; oh++) {
+       for (int ow = 0; ow < out_w; ow++) {
+         for (int c = 0; c < channel; c++) {
+           int32_t acc = 0;
+           for (int kh = 0; kh < kernel; kh++) {
+             for (int kw = 0; kw < kernel; kw++) {
+               int ih = oh * stride - pad + kh;
+               int iw = ow * stride - pad + kw;
+               if (ih < 0 || ih >= in_h || iw < 0 || iw >= in_w) {
+                 continue;
+               }
+               acc += (input[(ih * in_w + iw) * channel + c] - input_zp[c]) *
+                      weight[(c / C8NUM) * sliding.kernel_step_ + (kh * kernel + kw) * C8NUM + c % C8NUM];
+             }
+           }
+           acc += bias[c];
+           acc = MultiplyByQuantizedMultiplier(acc, quant_multiplier[c], left_shift[c], right_shift[c]) + output_zp[c];
+           acc = MSMIN(out_act_max[c], MSMAX(out_act_min[c], acc));
+           benchmark[(oh * out_w + ow) * channel + c] = static_cast<int8_t>(acc);
+         }
+       }
+     }
+
+     std::vector<int8_t> output(out_h * out_w * channel, 0);
+     ConvDwInt8SW(output.data(), input.data(), weight.data(), bias.data(), input_zp.data(), output_zp.data(),
+                  &conv_param, &sliding, 0);
+
+     std::cout << "ConvDwInt8Test-ConvDwInt8SW_LargeKernel kernel=" << kernel << " stride=" << stride
+               << " output " << out_h << "x" << out_w << "x" << channel << "\n";
+     for (size_t i = 0; i < output.size(); i++) {
+       ASSERT_EQ(output[i], benchmark[i]) << "kernel=" << kernel << " stride=" << stride << " index=" << i;
+     }
+   };
+
+   run_case(5, 1);
+   run_case(5, 2);
+   run_case(7, 1);
+   run_case(7, 2);
+ }
+
+ // Testcase3: ConvDwInt8SW with asymmetric per-channel input zero points
+ // Input: 1x6x6x16, 3x3 kernel, stride 1. Both the asymmetric run and the run with
+ // input_zp * sum(weight) folded into the bias (and all-zero input_zp) are checked against a
+ // scalar reference at every pixel. The two agree wherever the whole window is inside the input;
+ // on the border the folded accumulator is off by input_zp * sum(weight over skipped taps), and
+ // adding that correction must give back the asymmetric accumulator.
+ TEST_F(ConvDwInt8Test, ConvDwInt8SW_AsymmetricZp_FoldIntoBias) {
+   const int in_h = 6;
+   const int in_w = 6;
+   const int channel = 16;
+   const int kernel = 3;
+   const int c_block = UP_DIV(channel, C8NUM);
+
+   // Input: 1x6x6x16 (NHWC8 format)
+   std::vector<int8_t> input(in_h * in_w * channel);
+   for (size_t i = 0; i < input.size(); i++) {
+     input[i] = static_cast<int8_t>(static_cast<int>(i * 53 % 251) - 125);
+   }
+
+   // Weight: [c_block][3][3][8] (int16)
+   std::vector<int16_t> weight(c_block * kernel * kernel * C8NUM);
+   for (size_t i = 0; i < weight.size(); i++) {
+     weight[i] = static_cast<int16_t>(static_cast<int>(i * 11 % 23) - 11);
+   }
+
+   // Asymmetric (TFLite uint8 converted) input zero points, different for every channel
+   std::vector<int8_t> input_zp(channel);
+   std::vector<int32_t> bias(channel);
+   for (int c = 0; c < channel; c++) {
+     input_zp[c] = static_cast<int8_t>(c * 7 % 29 - 14);
+     bias[c] = c * 30 - 200;
+   }
+
+   // Bias with input_zp * sum(weight) folded in, computed once ahead of time
+   std::vector<int32_t> folded_bias(channel);
+   std::vector<int8_t> zero_zp(channel, 0);
+   for (int c = 0; c < channel; c++) {
+     int32_t weight_sum = 0;
+     for (int k = 0; k < kernel * kernel; k++) {
+       weight_sum += weight[(c / C8NUM) * kernel * kernel * C8NUM + k * C8NUM + c % C8NUM];
+     }
+     folded_bias[c] = bias[c] - input_zp[c] * weight_sum;
+   }
+
+   std::vector<int32_t> output_zp(channel, 5);
+   std::vector<int32_t> quant_multiplier(channel, 1073741824);
+   std::vector<int32_t> left_shift(channel, 0);
+   std::vector<int32_t> right_shift(channel, -6);
+   std::vector<int32_t> out_act_min(channel, -128);
+   std::vector<int32_t> out_act_max(channel, 127);
+   QuantArg input_quant_args[1] = {{1.0f, 0}};
+   QuantArg output_quant_args[1] = {{1.0f, 5}};
+
+   auto run_case = [&](int pad) {
+     const int out_h = in_h + 2 * pad - kernel + 1;
+     const int out_w = in_w + 2 * pad - kernel + 1;
+
+     ConvParameter conv_param;
+     memset(&conv_param, 0, sizeof(ConvParameter));
+     conv_param.kernel_h_ = kernel;
+     conv_param.kernel_w_ = kernel;
+     conv_param.stride_h_ = 1;
+     conv_param.stride_w_ = 1;
+     conv_param.dilation_h_ = 1;
+     conv_param.dilation_w_ = 1;
+     conv_param.pad_u_ = pad;
+     conv_param.pad_d_ = pad;
+     conv_param.pad_l_ = pad;
+     conv_param.pad_r_ = pad;
+     conv_param.input_batch_ = 1;
+     conv_param.input_h_ = in_h;
+     conv_param.input_w_ = in_w;
+     conv_param.input_channel_ = channel;
+     conv_param.output_batch_ = 1;
+     conv_param.output_h_ = out_h;
+     conv_param.output_w_ = out_w;
+     conv_param.output_channel_ = channel;
+     conv_param.thread_num_ = 1;
+     conv_param.conv_quant_arg_.input_quant_args_ = input_quant_args;
+     conv_param.conv_quant_arg_.output_quant_args_ = output_quant_args;
+     conv_param.conv_quant_arg_.quant_multiplier_ = quant_multiplier.data();
+     conv_param.conv_quant_arg_.left_shift_ = left_shift.data();
+     conv_param.conv_quant_arg_.right_shift_ = right_shift.data();
+     conv_param.conv_quant_arg_.out_act_min_ = out_act_min.data();
+     conv_param.conv_quant_arg_.out_act_max_ = out_act_max.data();
+     conv_param.conv_quant_arg_.per_channel_ = FILTER_PER_CHANNEL;
+
+     SlidingWindowParam sliding;
+     memset(&sliding, 0, sizeof(SlidingWindowParam));
+     sliding.left_ = pad;
+     sliding.right_ = out_w - pad;
+     sliding.top_ = pad;
+     sliding.bottom_ = out_h - pad;
+     sliding.c_block_ = c_block;
+     sliding.block_channel_ = c_block * C8NUM;
+     sliding.out_step_ = out_h * out_w * sliding.block_channel_;
+     sliding.out_h_step_ = out_w * sliding.block_channel_;
+     sliding.in_step_ = in_h * in_w * sliding.block_channel_;
+     sliding.in_h_step_ = in_w * sliding.block_channel_;
+     sliding.in_sh_step_ = sliding.in_h_step_;
+     sliding.in_sw_step_ = sliding.block_channel_;
+     sliding.in_kh_step_ = sliding.in_h_step_;
+     sliding.in_kw_step_ = sliding.block_channel_;
+     sliding.kernel_step_ = kernel * kernel * C8NUM;
+
+     // Asymmetric path: zero point subtracted for every tap
+     std::vector<int8_t> output_asym(out_h * out_w * channel, 0);
+     ConvDwInt8SW(output_asym.data(), input.data(), weight.data(), bias.data(), input_zp.data(), output_zp.data(),
+                  &conv_param, &sliding, 0);
+
+     // Symmetric path: zero point already folded into the bias
+     std::vector<int8_t> output_folded(out_h * out_w * channel, 0);
+     ConvDwInt8SW(output_folded.data(), input.data(), weight.data(), folded_bias.data(), zero_zp.data(),
+                  output_zp.data(), &conv_param, &sliding, 0);
+
+     std::cout << "ConvDwInt8Test-ConvDwInt8SW_AsymmetricZp_FoldIntoBias pad=" << pad << " output (row 1):\n";
+     for (int i = 0; i < out_w * channel; i++) {
+       std::cout << static_cast<int32_t>(output_asym[out_w * channel + i]) << " ";
+     }
+     std::cout << "\n";
+
+     // Scalar reference accumulators; padded taps are skipped, i.e. they behave as input == zp
+     int mismatched_border = 0;
+     for (int oh = 0; oh < out_h; oh++) {
+       for (int ow = 0; ow < out_w; ow++) {
+         const bool center = oh >= sliding.top_ && oh < sliding.bottom_ && ow >= sliding.left_ && ow < sliding.right_;
+         for (int c = 0; c < channel; c++) {
+           int32_t acc_asym = bias[c];
+           int32_t acc_folded = folded_bias[c];
+           int32_t skipped_weight_sum = 0;
+           for (int kh = 0; kh < kernel; kh++) {
+             for (int kw = 0; kw < kernel; kw++) {
+               int32_t w = weight[(c / C8NUM) * kernel * kernel * C8NUM + (kh * kernel + kw) * C8NUM + c % C8NUM];
+               int ih = oh - pad + kh;
+               int iw = ow - pad + kw;
+               if (ih < 0 || ih >= in_h || iw < 0 || iw >= in_w) {
+                 skipped_weight_sum += w;
+                 continue;
+               }
+               int32_t x = input[(ih * in_w + iw) * channel + c];
+               acc_asym += (x - input_zp[c]) * w;
+               acc_folded += x * w;
+             }
+           }
+           // The precomputed fold is exact only when no tap is skipped; the border needs the correction
+           ASSERT_EQ(acc_folded + input_zp[c] * skipped_weight_sum, acc_asym)
+             << "pad=" << pad << " oh=" << oh << " ow=" << ow << " c=" << c;
+           if (center) {
+             ASSERT_EQ(skipped_weight_sum, 0) << "pad=" << pad << " oh=" << oh << " ow=" << ow;
+           }
+
+           auto requant = [&](int32_t acc) {
+             int32_t value =
+               MultiplyByQuantizedMultiplier(acc, quant_multiplier[c], left_shift[c], right_shift[c]) + output_zp[c];
+             return static_cast<int8_t>(MSMIN(out_act_max[c], MSMAX(out_act_min[c], value)));
+           };
+           int index = (oh * out_w + ow) * channel + c;
+           ASSERT_EQ(output_asym[index], requant(acc_asym)) << "pad=" << pad << " oh=" << oh << " ow=" << ow
+                                                            << " c=" << c;
+           ASSERT_EQ(output_folded[index], requant(acc_folded)) << "pad=" << pad << " oh=" << oh << " ow=" << ow
+                                                                << " c=" << c;
+           if (center) {
+             ASSERT_EQ(output_asym[index], output_folded[index]) << "pad=" << pad << " oh=" << oh << " ow=" << ow
+                                                                 << " c=" << c;
+           } else if (output_asym[index] != output_folded[index]) {
+             mismatched_border++;
+           }
+         }
+       }
+     }
+     // With padding, folding alone must visibly differ on the border, otherwise the case pins nothing
+     if (pad > 0) {
+       EXPECT_GT(mismatched_border, 0) << "pad=" << pad;
+     }
+   };
+
+   run_case(0);
+   run_case(1);
+ }
+
+ // Testcase4: ConvDwInt8SW reading the requant params from an aligned per-channel requant plan
+ // Input: 1x6x6x12 packed to NHWC8 (block_channel 16), 3x3 kernel, stride 1, pad 1
+ // ConvDwInt8SW walks whole C8NUM blocks and indexes the multiplier, shifts and act range per channel,
+ // so the plan rows here span block_channel entries (the padded lanes repeat channel 11) and the act
+ // rows carry a different range for every channel. The output is checked against a scalar reference,
+ // and some pixels have to be clamped to a bound that belongs to their own channel only.
+ TEST_F(ConvDwInt8Test, ConvDwInt8SW_RequantPlanPerChannel) {
+   const int in_h = 6;
+   const int in_w = 6;
+   const int channel = 12;
+   const int kernel = 3;
+   const int pad = 1;
+   const int out_h = in_h;
+   const int out_w = in_w;
+   const int c_block = UP_DIV(channel, C8NUM);
+   const int block_channel = 16;  // c_block * C8NUM
+   ASSERT_EQ(block_channel, c_block * C8NUM);
+
+   // Input: 1x6x6x12, padded lanes of the NHWC8 layout are zero
+   std::vector<int8_t> input(in_h * in_w * block_channel, 0);
+   for (int p = 0; p < in_h * in_w; p++) {
+     for (int c = 0; c < channel; c++) {
+       input[p * block_channel + c] = static_cast<int8_t>(static_cast<int>((p * channel + c) * 37 % 249) - 124);
+     }
+   }
+
+   // Weight: [c_block][3][3][8] (int16), padded lanes zero
+   std::vector<int16_t> weight(c_block * kernel * kernel * C8NUM, 0);
+   for (int c = 0; c < channel; c++) {
+     for (int k = 0; k < kernel * kernel; k++) {
+       weight[(c / C8NUM) * kernel * kernel * C8NUM + k * C8NUM + c % C8NUM] =
+         static_cast<int16_t>(static_cast<int>((c * 9 + k) * 13 % 25) - 12);
+     }
+   }
+   std::vector<int32_t> bias(block_channel, 0);
+   for (int c = 0; c < channel; c++) {
+     bias[c] = c * 45 - 250;
+   }
+   std::vector<int8_t> input_zp(block_channel, 0);
+   std::vector<int32_t> output_zp(block_channel, 2);
+   QuantArg input_quant_args[1] = {{1.0f, 0}};
+   QuantArg output_quant_args[1] = {{1.0f, 2}};
+
+   // Per-channel values; the act range narrows and shifts upward with the channel index
+   std::vector<int32_t> multiplier(channel);
+   std::vector<int32_t> left_shift(channel);
+   std::vector<int32_t> right_shift(channel);
+   std::vector<int32_t> act_min(channel);
+   std::vector<int32_t> act_max(channel);
+   for (int c = 0; c < channel; c++) {
+     multiplier[c] = 1073741824 + c * 70000000;
+     left_shift[c] = c % 2;
+     right_shift[c] = -6 - c % 3;
+     act_min[c] = -50 + 6 * c;
+     act_max[c] = 5 + 5 * c;
+   }
+
+   // One row per requant param, each a whole number of 32-byte blocks, so every row starts aligned
+   struct alignas(C8NUM * sizeof(int32_t)) RequantPlan {
+     int32_t multiplier[block_channel];
+     int32_t left_shift[block_channel];
+     int32_t right_shift[block_channel];
+     int32_t act_min[block_channel];
+     int32_t act_max[block_channel];
+   };
+   std::unique_ptr<RequantPlan> plan(new RequantPlan);
+   for (int c = 0; c < block_channel; c++) {
+     const int src = MSMIN(c, channel - 1);
+     plan->multiplier[c] = multiplier[src];
+     plan->left_shift[c] = left_shift[src];
+     plan->right_shift[c] = right_shift[src];
+     plan->act_min[c] = act_min[src];
+     plan->act_max[c] = act_max[src];
+   }
+   for (const int32_t *row : {plan->multiplier, plan->left_shift, plan->right_shift, plan->act_min, plan->act_max}) {
+     ASSERT_EQ(reinterpret_cast<uintptr_t>(row) % (C8NUM * sizeof(int32_t)), 0u);
+   }
+
+   ConvParameter conv_param;
+   memset(&conv_param, 0, sizeof(ConvParameter));
+   conv_param.kernel_h_ = kernel;
+   conv_param.kernel_w_ = kernel;
+   conv_param.stride_h_ = 1;
+   conv_param.stride_w_ = 1;
+   conv_param.dilation_h_ = 1;
+   conv_param.dilation_w_ = 1;
+   conv_param.pad_u_ = pad;
+   conv_param.pad_d_ = pad;
+   conv_param.pad_l_ = pad;
+   conv_param.pad_r_ = pad;
+   conv_param.input_batch_ = 1;
+   conv_param.input_h_ = in_h;
+   conv_param.input_w_ = in_w;
+   conv_param.input_channel_ = channel;
+   conv_param.output_batch_ = 1;
+   conv_param.output_h_ = out_h;
+   conv_param.output_w_ = out_w;
+   conv_param.output_channel_ = channel;
+   conv_param.thread_num_ = 1;
+   conv_param.conv_quant_arg_.input_quant_args_ = input_quant_args;
+   conv_param.conv_quant_arg_.output_quant_args_ = output_quant_args;
+   conv_param.conv_quant_arg_.quant_multiplier_ = plan->multiplier;
+   conv_param.conv_quant_arg_.left_shift_ = plan->left_shift;
+   conv_param.conv_quant_arg_.right_shift_ = plan->right_shift;
+   conv_param.conv_quant_arg_.out_act_min_ = plan->act_min;
+   conv_param.conv_quant_arg_.out_act_max_ = plan->act_max;
+   conv_param.conv_quant_arg_.per_channel_ = FILTER_PER_CHANNEL;
+
+   SlidingWindowParam sliding;
+   memset(&sliding, 0, sizeof(SlidingWindowParam));
+   sliding.left_ = pad;
+   sliding.right_ = out_w - pad;
+   sliding.top_ = pad;
+   sliding.bottom_ = out_h - pad;
+   sliding.c_block_ = c_block;
+   sliding.block_channel_ = block_channel;
+   sliding.out_step_ = out_h * out_w * block_channel;
+   sliding.out_h_step_ = out_w * block_channel;
+   sliding.in_step_ = in_h * in_w * block_channel;
+   sliding.in_h_step_ = in_w * block_channel;
+   sliding.in_sh_step_ = sliding.in_h_step_;
+   sliding.in_sw_step_ = block_channel;
+   sliding.in_kh_step_ = sliding.in_h_step_;
+   sliding.in_kw_step_ = block_channel;
+   sliding.kernel_step_ = kernel * kernel * C8NUM;
+
+   std::vector<int8_t> output(out_h * out_w * block_channel, 0);
+   ConvDwInt8SW(output.data(), input.data(), weight.data(), bias.data(), input_zp.data(), output_zp.data(),
+                &conv_param, &sliding, 0);
+
+   std::cout << "ConvDwInt8Test-ConvDwInt8SW_RequantPlanPerChannel output (row 1):\n";
+   for (int i = 0; i < out_w * block_channel; i++) {
+     std::cout << static_cast<int32_t>(output[out_w * block_channel + i]) << " ";
+   }
+   std::cout << "\n";
+
+   // A value clamped to its own channel's bound that channel 0's range would have let through (or
+   // clamped elsewhere) shows the kernel read act_min/act_max at the channel, not at [0]
+   int clamped_per_channel = 0;
+   int distinct_params = 0;
+   for (int oh = 0; oh < out_h; oh++) {
+     for (int ow = 0; ow < out_w; ow++) {
+       for (int c = 0; c < channel; c++) {
+         int32_t acc = bias[c];
+         for (int kh = 0; kh < kernel; kh++) {
+           for (int kw = 0; kw < kernel; kw++) {
+             int ih = oh - pad + kh;
+             int iw = ow - pad + kw;
+             if (ih < 0 || ih >= in_h || iw < 0 || iw >= in_w) {
+               continue;
+             }
+             acc += input[(ih * in_w + iw) * block_channel + c] *
+                    weight[(c / C8NUM) * kernel * kernel * C8NUM + (kh * kernel + kw) * C8NUM + c % C8NUM];
+           }
+         }
+         int32_t value =
+           MultiplyByQuantizedMultiplier(acc, multiplier[c], left_shift[c], right_shift[c]) + output_zp[c];
+         int32_t expected = MSMIN(act_max[c], MSMAX(act_min[c], value));
+         int32_t with_layer_act = MSMIN(act_max[0], MSMAX(act_min[0], value));
+         if (expected != value && expected != with_layer_act) {
+           clamped_per_channel++;
+         }
+         int32_t with_layer_params =
+           MultiplyByQuantizedMultiplier(acc, multiplier[0], left_shift[0], right_shift[0]) + output_zp[c];
+         if (MSMIN(act_max[c], MSMAX(act_min[c], with_layer_params)) != expected) {
+           distinct_params++;
+         }
+         int index = (oh * out_w + ow) * block_channel + c;
+         ASSERT_EQ(output[index], static_cast<int8_t>(expected)) << "oh=" << oh << " ow=" << ow << " c=" << c;
+       }
+     }
+   }
+   EXPECT_GT(clamped_per_channel, 0);
+   EXPECT_GT(distinct_params, 0);
  }
\ No newline at end of file
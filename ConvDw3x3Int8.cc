@@ -187,3 +187,337 @@
    delete[] conv_param.conv_quant_arg_.out_act_min_;
    delete[] conv_param.conv_quant_arg_.out_act_max_;
  }
+
+ // Testcase2: two chained ConvDw3x3Int8 layers pipelined by output row bands
+ // Layer1: 1x12x12x8 -> 1x10x10x8, Layer2: 1x10x10x8 -> 1x8x8x8, 3x3 kernel, stride 1, no padding.
+ // Layer1 runs its bands on one thread; layer2 starts a band on a second thread as soon as the
+ // layer1 rows it reads have been produced. The result must equal running the layers back to back.
+ TEST_F(ConvDw3x3Int8Test, ConvDw3x3Int8_RowBandPipeline) {
+   const int channel = 8;
+   const int band_rows = 2;
+   const int in_h = 12;
+   const int in_w = 12;
+   const int mid_h = in_h - 2;
+   const int mid_w = in_w - 2;
+   const int out_h = mid_h - 2;
+   const int out_w = mid_w - 2;
+
+   std::vector<int8_t> input(in_h * in_w * channel);
+   for (size_t i = 0; i < input.size(); i++) {
+     input[i] = static_cast<int8_t>(static_cast<int>(i * 41 % 199) - 99);
+   }
+   // Weight: 3x3x8 per layer
+   std::vector<int16_t> weight1(9 * channel);
+   std::vector<int16_t> weight2(9 * channel);
+   for (int i = 0; i < 9 * channel; i++) {
+     weight1[i] = static_cast<int16_t>(i % 7 - 3);
+     weight2[i] = static_cast<int16_t>(i % 5 - 2);
+   }
+   std::vector<int32_t> bias1(channel, 10);
+   std::vector<int32_t> bias2(channel, -10);
+
+   // Per-layer quantization shared by both layers
+   QuantArg input_quant_args[1] = {{1.0f, 0}};
+   QuantArg filter_quant_args[1] = {{1.0f, 0}};
+   QuantArg output_quant_args[1] = {{1.0f, 0}};
+   std::vector<int32_t> quant_multiplier(channel, 1073741824);
+   std::vector<int32_t> left_shift(channel, 0);
+   std::vector<int32_t> right_shift(channel, -2);
+   int32_t out_act_min[1] = {-128};
+   int32_t out_act_max[1] = {127};
+
+   auto make_param = [&](int ih, int iw, int oh, int ow) {
+     ConvParameter conv_param;
+     memset(&conv_param, 0, sizeof(ConvParameter));
+     conv_param.kernel_h_ = 3;
+     conv_param.kernel_w_ = 3;
+     conv_param.stride_h_ = 1;
+     conv_param.stride_w_ = 1;
+     conv_param.dilation_h_ = 1;
+     conv_param.dilation_w_ = 1;
+     conv_param.input_batch_ = 1;
+     conv_param.input_h_ = ih;
+     conv_param.input_w_ = iw;
+     conv_param.input_channel_ = channel;
+     conv_param.output_batch_ = 1;
+     conv_param.output_h_ = oh;
+     conv_param.output_w_ = ow;
+     conv_param.output_channel_ = channel;
+     conv_param.thread_num_ = 1;
+     conv_param.group_ = channel;
+     conv_param.conv_quant_arg_.input_quant_args_ = input_quant_args;
+     conv_param.conv_quant_arg_.filter_quant_args_ = filter_quant_args;
+     conv_param.conv_quant_arg_.output_quant_args_ = output_quant_args;
+     conv_param.conv_quant_arg_.quant_multiplier_ = quant_multiplier.data();
+     conv_param.conv_quant_arg_.left_shift_ = left_shift.data();
+     conv_param.conv_quant_arg_.right_shift_ = right_shift.data();
+     conv_param.conv_quant_arg_.out_act_min_ = out_act_min;
+     conv_param.conv_quant_arg_.out_act_max_ = out_act_max;
+     conv_param.conv_quant_arg_.per_channel_ = 0;
+     return conv_param;
+   };
+   auto make_sliding = [&](int ih, int iw, int oh, int ow) {
+     SlidingWindowParam sliding;
+     memset(&sliding, 0, sizeof(SlidingWindowParam));
+     sliding.left_ = 0;
+     sliding.right_ = ow;
+     sliding.top_ = 0;
+     sliding.bottom_ = oh;
+     sliding.c_block_ = channel / 8;
+     sliding.block_channel_ = channel;
+     sliding.ic_align_ = channel;
+     sliding.out_step_ = oh * ow * channel;
+     sliding.out_h_step_ = ow * channel;
+     sliding.out_c_step_ = 1;
+     sliding.out_w_step_ = channel;
+     sliding.in_step_ = ih * iw * channel;
+     sliding.in_h_step_ = iw * channel;
+     sliding.in_sh_step_ = iw * channel;
+     sliding.in_sw_step_ = channel;
+     sliding.in_kh_step_ = iw * channel;
+     sliding.in_kw_step_ = channel;
+     sliding.kernel_step_ = 9 * channel;
+     return sliding;
+   };
+   ConvParameter param1 = make_param(in_h, in_w, mid_h, mid_w);
+   ConvParameter param2 = make_param(mid_h, mid_w, out_h, out_w);
+   SlidingWindowParam sliding1 = make_sliding(in_h, in_w, mid_h, mid_w);
+   SlidingWindowParam sliding2 = make_sliding(mid_h, mid_w, out_h, out_w);
+
+   // One scratch block per worker
+   const int buffer_size = 3 * (1 * (30 - 1) + 3) * 64;
+   std::vector<int8_t> buffer1(buffer_size, 0);
+   std::vector<int8_t> buffer2(buffer_size, 0);
+
+   // Reference: layer by layer
+   std::vector<int8_t> mid_ref(mid_h * mid_w * channel, 0);
+   std::vector<int8_t> out_ref(out_h * out_w * channel, 0);
+   ConvDw3x3Int8(mid_ref.data(), buffer1.data(), input.data(), weight1.data(), bias1.data(), &param1, &sliding1, 0);
+   ConvDw3x3Int8(out_ref.data(), buffer2.data(), mid_ref.data(), weight2.data(), bias2.data(), &param2, &sliding2, 0);
+
+   // Pipelined: a band only covers sliding rows [top_, bottom_)
+   std::vector<int8_t> mid(mid_h * mid_w * channel, 0);
+   std::vector<int8_t> output(out_h * out_w * channel, 0);
+   std::atomic<int> mid_rows_ready(0);
+   std::thread producer([&]() {
+     for (int row = 0; row < mid_h; row += band_rows) {
+       SlidingWindowParam band = sliding1;
+       band.top_ = row;
+       band.bottom_ = MSMIN(row + band_rows, mid_h);
+       ConvDw3x3Int8(mid.data(), buffer1.data(), input.data(), weight1.data(), bias1.data(), &param1, &band, 0);
+       mid_rows_ready.store(band.bottom_, std::memory_order_release);
+     }
+   });
+   std::thread consumer([&]() {
+     for (int row = 0; row < out_h; row += band_rows) {
+       SlidingWindowParam band = sliding2;
+       band.top_ = row;
+       band.bottom_ = MSMIN(row + band_rows, out_h);
+       // Rows [top_, bottom_ + 2) of layer1 feed this band
+       while (mid_rows_ready.load(std::memory_order_acquire) < band.bottom_ + 2) {
+         std::this_thread::yield();
+       }
+       ConvDw3x3Int8(output.data(), buffer2.data(), mid.data(), weight2.data(), bias2.data(), &param2, &band, 0);
+     }
+   });
+   producer.join();
+   consumer.join();
+
+   std::cout << "ConvDw3x3Int8Test-ConvDw3x3Int8_RowBandPipeline output:\n";
+   for (size_t i = 0; i < output.size(); i++) {
+     std::cout << static_cast<int32_t>(output[i]) << ", ";
+     if ((i + 1) % 8 == 0) std::cout << "\n";
+   }
+   std::cout << std::endl;
+
+   EXPECT_EQ(mid, mid_ref);
+   EXPECT_EQ(output, out_ref);
+ }
+
+ // Testcase3: ConvDw3x3Int8 requant params in an aligned per-channel requant plan
+ // Input: 1x6x6x16, 3x3 kernel, stride 1, no padding. The 3x3 path is only selected for channel counts
+ // that are a multiple of C8NUM, so the plan rows here hold exactly `channel` entries with no padded
+ // tail; each row starts on a 32-byte block. Filling the plan with the per-layer values must be
+ // bit-exact with the per-layer path, and per-channel multipliers/shifts must match a scalar reference.
+ // The act range is read from out_act_min_[0]/out_act_max_[0] here, so it stays a per-layer value.
+ TEST_F(ConvDw3x3Int8Test, ConvDw3x3Int8_RequantPlanBroadcast) {
+   const int in_h = 6;
+   const int in_w = 6;
+   const int channel = 16;
+   const int out_h = 4;
+   const int out_w = 4;
+
+   std::vector<int8_t> input(in_h * in_w * channel);
+   for (size_t i = 0; i < input.size(); i++) {
+     input[i] = static_cast<int8_t>(static_cast<int>(i * 59 % 241) - 120);
+   }
+   // Weight: 3x3x16
+   std::vector<int16_t> weight(9 * channel);
+   for (size_t i = 0; i < weight.size(); i++) {
+     weight[i] = static_cast<int16_t>(static_cast<int>(i * 7 % 15) - 7);
+   }
+   std::vector<int32_t> bias(channel);
+   for (int c = 0; c < channel; c++) {
+     bias[c] = c * 40 - 300;
+   }
+
+   // Per-layer values
+   QuantArg input_quant_args[1] = {{1.0f, 0}};
+   QuantArg filter_quant_args[1] = {{1.0f, 0}};
+   QuantArg output_quant_args[1] = {{1.0f, 4}};
+   int32_t quant_multiplier = 1518500250;
+   int32_t left_shift = 0;
+   int32_t right_shift = -5;
+   int32_t out_act_min = -120;
+   int32_t out_act_max = 120;
+
+   // Plan rows are kept as whole C8NUM blocks; the block type carries the 32-byte alignment
+   struct alignas(C8NUM * sizeof(int32_t)) PlanBlock {
+     int32_t value[C8NUM];
+   };
+   enum PlanRow { kMultiplier, kLeftShift, kRightShift, kActMin, kActMax, kPlanRows };
+   const int row_blocks = channel / C8NUM;
+   auto make_plan = [&](const std::vector<int32_t> &multiplier, const std::vector<int32_t> &left,
+                        const std::vector<int32_t> &right) {
+     std::vector<PlanBlock> plan(kPlanRows * row_blocks);
+     for (int c = 0; c < channel; c++) {
+       plan[kMultiplier * row_blocks + c / C8NUM].value[c % C8NUM] = multiplier[c];
+       plan[kLeftShift * row_blocks + c / C8NUM].value[c % C8NUM] = left[c];
+       plan[kRightShift * row_blocks + c / C8NUM].value[c % C8NUM] = right[c];
+       plan[kActMin * row_blocks + c / C8NUM].value[c % C8NUM] = out_act_min;
+       plan[kActMax * row_blocks + c / C8NUM].value[c % C8NUM] = out_act_max;
+     }
+     return plan;
+   };
+   auto plan_row = [&](std::vector<PlanBlock> *plan, PlanRow row) {
+     return reinterpret_cast<int32_t *>(plan->data() + row * row_blocks);
+   };
+
+   SlidingWindowParam sliding;
+   memset(&sliding, 0, sizeof(SlidingWindowParam));
+   sliding.left_ = 0;
+   sliding.right_ = out_w;
+   sliding.top_ = 0;
+   sliding.bottom_ = out_h;
+   sliding.c_block_ = channel / 8;
+   sliding.block_channel_ = channel;
+   sliding.ic_align_ = channel;
+   sliding.out_step_ = out_h * out_w * channel;
+   sliding.out_h_step_ = out_w * channel;
+   sliding.out_c_step_ = 1;
+   sliding.out_w_step_ = channel;
+   sliding.in_step_ = in_h * in_w * channel;
+   sliding.in_h_step_ = in_w * channel;
+   sliding.in_sh_step_ = in_w * channel;
+   sliding.in_sw_step_ = channel;
+   sliding.in_kh_step_ = in_w * channel;
+   sliding.in_kw_step_ = channel;
+   sliding.kernel_step_ = 9 * channel;
+
+   std::vector<int8_t> buffer(3 * (30 - 1 + 3) * 64, 0);
+   auto run_conv = [&](std::vector<PlanBlock> *plan, int8_t *output) {
+     ConvParameter conv_param;
+     memset(&conv_param, 0, sizeof(ConvParameter));
+     conv_param.kernel_h_ = 3;
+     conv_param.kernel_w_ = 3;
+     conv_param.stride_h_ = 1;
+     conv_param.stride_w_ = 1;
+     conv_param.dilation_h_ = 1;
+     conv_param.dilation_w_ = 1;
+     conv_param.input_batch_ = 1;
+     conv_param.input_h_ = in_h;
+     conv_param.input_w_ = in_w;
+     conv_param.input_channel_ = channel;
+     conv_param.output_batch_ = 1;
+     conv_param.output_h_ = out_h;
+     conv_param.output_w_ = out_w;
+     conv_param.output_channel_ = channel;
+     conv_param.thread_num_ = 1;
+     conv_param.group_ = channel;
+     conv_param.conv_quant_arg_.input_quant_args_ = input_quant_args;
+     conv_param.conv_quant_arg_.filter_quant_args_ = filter_quant_args;
+     conv_param.conv_quant_arg_.output_quant_args_ = output_quant_args;
+     if (plan != nullptr) {
+       for (int row = 0; row < kPlanRows; row++) {
+         ASSERT_EQ(reinterpret_cast<uintptr_t>(plan_row(plan, static_cast<PlanRow>(row))) % alignof(PlanBlock), 0u);
+       }
+       conv_param.conv_quant_arg_.quant_multiplier_ = plan_row(plan, kMultiplier);
+       conv_param.conv_quant_arg_.left_shift_ = plan_row(plan, kLeftShift);
+       conv_param.conv_quant_arg_.right_shift_ = plan_row(plan, kRightShift);
+       conv_param.conv_quant_arg_.out_act_min_ = plan_row(plan, kActMin);
+       conv_param.conv_quant_arg_.out_act_max_ = plan_row(plan, kActMax);
+       conv_param.conv_quant_arg_.per_channel_ = FILTER_PER_CHANNEL;
+     } else {
+       conv_param.conv_quant_arg_.quant_multiplier_ = &quant_multiplier;
+       conv_param.conv_quant_arg_.left_shift_ = &left_shift;
+       conv_param.conv_quant_arg_.right_shift_ = &right_shift;
+       conv_param.conv_quant_arg_.out_act_min_ = &out_act_min;
+       conv_param.conv_quant_arg_.out_act_max_ = &out_act_max;
+       conv_param.conv_quant_arg_.per_channel_ = 0;
+     }
+     ConvDw3x3Int8(output, buffer.data(), input.data(), weight.data(), bias.data(), &conv_param, &sliding, 0);
+   };
+
+   // Per-layer values copied into every channel of the plan
+   auto broadcast_plan = make_plan(std::vector<int32_t>(channel, quant_multiplier),
+                                   std::vector<int32_t>(channel, left_shift),
+                                   std::vector<int32_t>(channel, right_shift));
+   std::vector<int8_t> per_layer_output(out_h * out_w * channel, 0);
+   std::vector<int8_t> plan_output(out_h * out_w * channel, 0);
+   run_conv(nullptr, per_layer_output.data());
+   run_conv(&broadcast_plan, plan_output.data());
+
+   std::cout << "ConvDw3x3Int8Test-ConvDw3x3Int8_RequantPlanBroadcast output:\n";
+   for (size_t i = 0; i < plan_output.size(); i++) {
+     std::cout << static_cast<int32_t>(plan_output[i]) << ", ";
+     if ((i + 1) % 16 == 0) std::cout << "\n";
+   }
+   std::cout << std::endl;
+
+   EXPECT_EQ(plan_output, per_layer_output);
+
+   // Per-channel multiplier/shifts; the per-layer act range is narrowed so some pixels clamp
+   std::vector<int32_t> channel_multiplier(channel);
+   std::vector<int32_t> channel_left_shift(channel);
+   std::vector<int32_t> channel_right_shift(channel);
+   for (int c = 0; c < channel; c++) {
+     channel_multiplier[c] = 1073741824 + c * 50000000;
+     channel_left_shift[c] = c % 2;
+     channel_right_shift[c] = -4 - c % 3;
+   }
+   out_act_min = -60;
+   out_act_max = 50;
+   auto channel_plan = make_plan(channel_multiplier, channel_left_shift, channel_right_shift);
+   std::vector<int8_t> channel_output(out_h * out_w * channel, 0);
+   run_conv(&channel_plan, channel_output.data());
+
+   int clamped = 0;
+   int differs_from_broadcast = 0;
+   for (int oh = 0; oh < out_h; oh++) {
+     for (int ow = 0; ow < out_w; ow++) {
+       for (int c = 0; c < channel; c++) {
+         int32_t acc = bias[c];
+         for (int kh = 0; kh < 3; kh++) {
+           for (int kw = 0; kw < 3; kw++) {
+             acc += input[((oh + kh) * in_w + ow + kw) * channel + c] * weight[(kh * 3 + kw) * channel + c];
+           }
+         }
+         int32_t value =
+           MultiplyByQuantizedMultiplier(acc, channel_multiplier[c], channel_left_shift[c], channel_right_shift[c]) +
+           output_quant_args[0].zp_;
+         if (value < out_act_min || value > out_act_max) {
+           clamped++;
+         }
+         value = MSMIN(out_act_max, MSMAX(out_act_min, value));
+         const int index = (oh * out_w + ow) * channel + c;
+         EXPECT_EQ(channel_output[index], static_cast<int8_t>(value)) << "per-channel plan mismatch at index " << index;
+         if (channel_output[index] != plan_output[index]) {
+           differs_from_broadcast++;
+         }
+       }
+     }
+   }
+   // The narrowed range must actually clamp, and the per-channel shifts must move some outputs
+   EXPECT_GT(clamped, 0);
+   EXPECT_GT(differs_from_broadcast, 0);
+ }
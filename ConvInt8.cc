@@ -380,3 +380,890 @@ TEST_F(ConvInt8Test, ConvInt8_optimize_true_larger) {
     EXPECT_LE(val, 127);
   }
 }
+
+// Testcase4: grouped convolution (group=2) split per group onto group_=1 ConvInt8 calls,
+// is_optimize=false, two tasks
+// Input: batch=1, h=3, w=3, in_c=4, out_c=4, kernel=3x3, pad=1
+// Per-group split reference for the (group x tile) scheduling contract: every group is sliced and
+// packed up front, then the flattened (group x tile) units are dealt to the tasks round-robin in
+// (group, tile) order, each unit being one tile of one group. All units write per-group outputs
+// that are scattered back into NHWC once; the result must match a scalar grouped convolution.
+TEST_F(ConvInt8Test, ConvInt8_group2_per_group_reference) {
+  const int batch = 1;
+  const int in_h = 3;
+  const int in_w = 3;
+  const int in_c = 4;
+  const int out_c = 4;
+  const int kernel_h = 3;
+  const int kernel_w = 3;
+  const int out_h = 3;
+  const int out_w = 3;
+  const int group = 2;
+  const int thread_num = 2;
+  const int in_c_per_group = in_c / group;    // 2
+  const int out_c_per_group = out_c / group;  // 2
+
+  // Input data: [1, 3, 3, 4] -> NHWC format
+  std::vector<int8_t> input_data(batch * in_h * in_w * in_c);
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    input_data[i] = static_cast<int8_t>(static_cast<int>(i * 29 % 61) - 30);
+  }
+
+  // Origin weight: [out_c, kernel_h, kernel_w, in_c_per_group], small values keep the
+  // accumulator away from the clamp so every channel carries information
+  const int kernel_plane = kernel_h * kernel_w;
+  const int deep = kernel_plane * in_c_per_group;  // 9 * 2 = 18
+  std::vector<int8_t> origin_weight(out_c * deep);
+  for (size_t i = 0; i < origin_weight.size(); ++i) {
+    origin_weight[i] = static_cast<int8_t>(static_cast<int>(i * 7 % 17) - 8);
+  }
+
+  // Bias for 4 output channels
+  std::vector<int32_t> bias_data = {100, -50, 0, 25};
+
+  // Filter zero points for per-channel quantization
+  std::vector<int32_t> filter_zp = {0, 0, 0, 0};
+
+  // Setup quantization parameters (per-channel, sliced per group below)
+  QuantArg input_quant_arg = {0.5f, 0};
+  QuantArg filter_quant_args[4] = {{0.01f, 0}, {0.01f, 0}, {0.02f, 0}, {0.02f, 0}};
+  QuantArg output_quant_arg = {0.5f, 3};
+  int32_t out_act_min = -128;
+  int32_t out_act_max = 127;
+  int32_t left_shift[4] = {0, 0, 0, 0};
+  int32_t right_shift[4] = {-6, -6, -7, -7};
+  int32_t quant_multiplier[4] = {1073741824, 1610612736, 1073741824, 1610612736};
+
+  // Scalar reference: grouped convolution followed by the same requantization as the GEMM epilogue
+  std::vector<int8_t> benchmark(batch * out_h * out_w * out_c, 0);
+  for (int oh = 0; oh < out_h; ++oh) {
+    for (int ow = 0; ow < out_w; ++ow) {
+      for (int oc = 0; oc < out_c; ++oc) {
+        const int g = oc / out_c_per_group;
+        int32_t acc = bias_data[oc];
+        for (int kh = 0; kh < kernel_h; ++kh) {
+          for (int kw = 0; kw < kernel_w; ++kw) {
+            const int ih = oh - 1 + kh;
+            const int iw = ow - 1 + kw;
+            if (ih < 0 || ih >= in_h || iw < 0 || iw >= in_w) {
+              continue;
+            }
+            for (int ic = 0; ic < in_c_per_group; ++ic) {
+              acc += input_data[(ih * in_w + iw) * in_c + g * in_c_per_group + ic] *
+                     origin_weight[oc * deep + (kh * kernel_w + kw) * in_c_per_group + ic];
+            }
+          }
+        }
+        int32_t value =
+          MultiplyByQuantizedMultiplier(acc, quant_multiplier[oc], left_shift[oc], right_shift[oc]) +
+          output_quant_arg.zp_;
+        value = MSMIN(out_act_max, MSMAX(out_act_min, value));
+        benchmark[(oh * out_w + ow) * out_c + oc] = static_cast<int8_t>(value);
+      }
+    }
+  }
+
+  // Per-group buffers, sized for is_optimize=false
+  const int tile_num = 4;
+  const int unit_size = UP_ROUND(deep, C16NUM);              // UP_ROUND(18, 16) = 32
+  const int up_round_oc = UP_ROUND(out_c_per_group, C4NUM);  // UP_ROUND(2, 4) = 4
+  const int input_sum_offset = tile_num * up_round_oc;       // per-channel: 4 * 4 = 16
+  const int tiles_per_group = UP_DIV(out_h * out_w, tile_num);  // UP_DIV(9, 4) = 3
+  const int unit_num = group * tiles_per_group;                 // 6 (group x tile) units
+  std::vector<std::vector<int8_t>> group_input(group, std::vector<int8_t>(batch * in_h * in_w * in_c_per_group));
+  std::vector<std::vector<int8_t>> group_output(group,
+                                                std::vector<int8_t>(batch * out_h * out_w * out_c_per_group, 0));
+  std::vector<std::vector<int8_t>> packed_weight(group, std::vector<int8_t>(up_round_oc * unit_size, 0));
+  // ConvInt8 addresses scratch by its task_id, which is the tile index here, so every (group, tile)
+  // unit owns its own slice and units can run in any order
+  std::vector<std::vector<int8_t>> packed_input(group, std::vector<int8_t>(unit_size * tile_num * tiles_per_group));
+  std::vector<std::vector<int8_t>> matmul_input(group, std::vector<int8_t>(deep * tile_num * tiles_per_group));
+  std::vector<std::vector<int32_t>> input_sum(group, std::vector<int32_t>(input_sum_offset * tiles_per_group));
+  std::vector<ConvParameter> group_param(group);
+
+  for (int g = 0; g < group; ++g) {
+    // Slice this group's input channels out of the NHWC tensor and pack its weights
+    for (int p = 0; p < batch * in_h * in_w; ++p) {
+      for (int ic = 0; ic < in_c_per_group; ++ic) {
+        group_input[g][p * in_c_per_group + ic] = input_data[p * in_c + g * in_c_per_group + ic];
+      }
+    }
+    RowMajor2Row16x4MajorInt8(origin_weight.data() + g * out_c_per_group * deep, packed_weight[g].data(),
+                              out_c_per_group, deep);
+
+    // Setup ConvParameter for one group; thread_num_ == tiles_per_group makes task_id select one tile
+    ConvParameter &conv_param = group_param[g];
+    memset(&conv_param, 0, sizeof(ConvParameter));
+
+    conv_param.input_batch_ = batch;
+    conv_param.input_h_ = in_h;
+    conv_param.input_w_ = in_w;
+    conv_param.input_channel_ = in_c_per_group;
+    conv_param.output_h_ = out_h;
+    conv_param.output_w_ = out_w;
+    conv_param.output_channel_ = out_c_per_group;
+    conv_param.kernel_h_ = kernel_h;
+    conv_param.kernel_w_ = kernel_w;
+    conv_param.stride_h_ = 1;
+    conv_param.stride_w_ = 1;
+    conv_param.pad_u_ = 1;
+    conv_param.pad_d_ = 1;
+    conv_param.pad_l_ = 1;
+    conv_param.pad_r_ = 1;
+    conv_param.dilation_h_ = 1;
+    conv_param.dilation_w_ = 1;
+    conv_param.group_ = 1;
+    conv_param.tile_num_ = tile_num;
+    conv_param.thread_num_ = tiles_per_group;
+
+    const int oc_offset = g * out_c_per_group;
+    conv_param.conv_quant_arg_.input_quant_args_ = &input_quant_arg;
+    conv_param.conv_quant_arg_.filter_quant_args_ = filter_quant_args + oc_offset;
+    conv_param.conv_quant_arg_.output_quant_args_ = &output_quant_arg;
+    conv_param.conv_quant_arg_.out_act_min_ = &out_act_min;
+    conv_param.conv_quant_arg_.out_act_max_ = &out_act_max;
+    conv_param.conv_quant_arg_.left_shift_ = left_shift + oc_offset;
+    conv_param.conv_quant_arg_.right_shift_ = right_shift + oc_offset;
+    conv_param.conv_quant_arg_.quant_multiplier_ = quant_multiplier + oc_offset;
+    conv_param.conv_quant_arg_.input_arg_num_ = 1;
+    conv_param.conv_quant_arg_.filter_arg_num_ = out_c_per_group;
+    conv_param.conv_quant_arg_.output_arg_num_ = 1;
+    conv_param.conv_quant_arg_.per_channel_ = FILTER_PER_CHANNEL;
+  }
+
+  // Task t runs units t, t + thread_num, ... of the flattened (group x tile) space, so a task may
+  // cross a group boundary; no task waits for a group to finish before starting the next one
+  std::vector<std::vector<int>> task_units(thread_num);
+  for (int task_id = 0; task_id < thread_num; ++task_id) {
+    for (int unit = task_id; unit < unit_num; unit += thread_num) {
+      task_units[task_id].push_back(unit);
+      const int g = unit / tiles_per_group;
+      const int tile = unit % tiles_per_group;
+      const int oc_offset = g * out_c_per_group;
+      ConvInt8(group_input[g].data(), packed_input[g].data(), matmul_input[g].data(), packed_weight[g].data(),
+               bias_data.data() + oc_offset, group_output[g].data(), filter_zp.data() + oc_offset,
+               input_sum[g].data(), tile, &group_param[g], nullptr, false);
+    }
+  }
+  // With 6 units over 2 tasks, task 0 owns tiles 0 and 2 of group 0 and tile 1 of group 1
+  ASSERT_EQ(task_units[0], std::vector<int>({0, 2, 4}));
+  ASSERT_EQ(task_units[1], std::vector<int>({1, 3, 5}));
+
+  // Single scatter of every group's output channels back into the NHWC tensor
+  std::vector<int8_t> output_data(batch * out_h * out_w * out_c, 0);
+  for (int g = 0; g < group; ++g) {
+    for (int p = 0; p < batch * out_h * out_w; ++p) {
+      for (int oc = 0; oc < out_c_per_group; ++oc) {
+        output_data[p * out_c + g * out_c_per_group + oc] = group_output[g][p * out_c_per_group + oc];
+      }
+    }
+  }
+
+  std::cout << "ConvInt8Test-ConvInt8_group2_per_group_reference output:\n";
+  for (size_t i = 0; i < output_data.size(); ++i) {
+    std::cout << static_cast<int32_t>(output_data[i]) << ", ";
+  }
+  std::cout << std::endl;
+
+  for (size_t i = 0; i < output_data.size(); ++i) {
+    EXPECT_EQ(output_data[i], benchmark[i]) << "Mismatch at index " << i;
+  }
+}
+
+// Testcase5: ConvInt8 tile_num_ x thread_num_ tuning sweep
+// For each layer shape every candidate must produce the same output; the fastest candidate is
+// reported and, when MSLITE_CONV_INT8_TUNING_CACHE names a file, stored in it one line per key as
+// "<host>/<hardware_threads> <in_h>x<in_w>x<in_c>_<out_c>_<k_h>x<k_w>_s<stride> <tile_num> <thread_num> <is_optimize>"
+// Entries for the same host and shape are replaced, so the file never holds conflicting lines.
+// Workers are spawned once per candidate and only the ConvInt8 calls are timed.
+// Disabled by default; run with --gtest_also_run_disabled_tests.
+TEST_F(ConvInt8Test, DISABLED_ConvInt8_tile_thread_tuning) {
+  struct LayerShape {
+    int in_h, in_w, in_c, out_c, kernel, stride;
+  };
+  const std::vector<LayerShape> shapes = {{28, 28, 32, 32, 1, 1}, {14, 14, 64, 64, 3, 1}, {14, 14, 96, 160, 1, 1}};
+  const std::vector<int> tile_candidates = {C4NUM, C8NUM, C12NUM, C16NUM, 24};
+  std::vector<int> thread_candidates = {1, 2, 4};
+  const int hardware_threads = static_cast<int>(std::thread::hardware_concurrency());
+  thread_candidates.erase(std::remove_if(thread_candidates.begin(), thread_candidates.end(),
+                                         [&](int n) { return hardware_threads > 0 && n > hardware_threads; }),
+                          thread_candidates.end());
+  std::vector<bool> optimize_candidates = {false};
+#ifdef ENABLE_ARM64
+  if (mindspore::lite::IsSupportSDot()) {
+    optimize_candidates.push_back(true);
+  }
+#endif
+  const int repeat = 3;
+  const char *cache_path = std::getenv("MSLITE_CONV_INT8_TUNING_CACHE");
+  char host_name[256] = {0};
+  if (gethostname(host_name, sizeof(host_name) - 1) != 0) {
+    strcpy(host_name, "unknown");
+  }
+  const std::string host_key = std::string(host_name) + "/" + std::to_string(hardware_threads);
+
+  // Existing cache entries keyed by "<host> <shape>", in file order
+  std::vector<std::pair<std::string, std::string>> cache_entries;
+  auto set_cache_entry = [&](const std::string &key, const std::string &value) {
+    for (auto &entry : cache_entries) {
+      if (entry.first == key) {
+        entry.second = value;
+        return;
+      }
+    }
+    cache_entries.emplace_back(key, value);
+  };
+  if (cache_path != nullptr) {
+    std::ifstream cache(cache_path);
+    std::string line;
+    while (std::getline(cache, line)) {
+      std::istringstream fields(line);
+      std::string host;
+      std::string shape_key;
+      if (!(fields >> host >> shape_key)) {
+        continue;
+      }
+      std::string value;
+      std::getline(fields >> std::ws, value);
+      set_cache_entry(host + " " + shape_key, value);
+    }
+  }
+
+  for (const auto &shape : shapes) {
+    const int pad = shape.kernel / 2;
+    const int out_h = (shape.in_h + 2 * pad - shape.kernel) / shape.stride + 1;
+    const int out_w = (shape.in_w + 2 * pad - shape.kernel) / shape.stride + 1;
+    const int deep = shape.kernel * shape.kernel * shape.in_c;
+
+    std::vector<int8_t> input_data(shape.in_h * shape.in_w * shape.in_c);
+    for (size_t i = 0; i < input_data.size(); ++i) {
+      input_data[i] = static_cast<int8_t>(static_cast<int>(i * 31 % 255) - 127);
+    }
+    std::vector<int8_t> origin_weight(shape.out_c * deep);
+    for (size_t i = 0; i < origin_weight.size(); ++i) {
+      origin_weight[i] = static_cast<int8_t>(static_cast<int>(i * 17 % 255) - 127);
+    }
+    std::vector<int32_t> bias_data(shape.out_c, 0);
+    std::vector<int32_t> filter_zp(shape.out_c, 0);
+
+    // Per-layer quantization
+    QuantArg input_quant_arg = {0.5f, 0};
+    QuantArg filter_quant_args = {0.01f, 0};
+    QuantArg output_quant_arg = {0.5f, 0};
+    int32_t out_act_min = -128;
+    int32_t out_act_max = 127;
+    int32_t left_shift = 0;
+    int32_t right_shift = -14;
+    int32_t quant_multiplier = 1073741824;
+
+    ConvParameter conv_param;
+    memset(&conv_param, 0, sizeof(ConvParameter));
+    conv_param.input_batch_ = 1;
+    conv_param.input_h_ = shape.in_h;
+    conv_param.input_w_ = shape.in_w;
+    conv_param.input_channel_ = shape.in_c;
+    conv_param.output_batch_ = 1;
+    conv_param.output_h_ = out_h;
+    conv_param.output_w_ = out_w;
+    conv_param.output_channel_ = shape.out_c;
+    conv_param.kernel_h_ = shape.kernel;
+    conv_param.kernel_w_ = shape.kernel;
+    conv_param.stride_h_ = shape.stride;
+    conv_param.stride_w_ = shape.stride;
+    conv_param.pad_u_ = pad;
+    conv_param.pad_d_ = pad;
+    conv_param.pad_l_ = pad;
+    conv_param.pad_r_ = pad;
+    conv_param.dilation_h_ = 1;
+    conv_param.dilation_w_ = 1;
+    conv_param.group_ = 1;
+    conv_param.conv_quant_arg_.input_quant_args_ = &input_quant_arg;
+    conv_param.conv_quant_arg_.filter_quant_args_ = &filter_quant_args;
+    conv_param.conv_quant_arg_.output_quant_args_ = &output_quant_arg;
+    conv_param.conv_quant_arg_.out_act_min_ = &out_act_min;
+    conv_param.conv_quant_arg_.out_act_max_ = &out_act_max;
+    conv_param.conv_quant_arg_.left_shift_ = &left_shift;
+    conv_param.conv_quant_arg_.right_shift_ = &right_shift;
+    conv_param.conv_quant_arg_.quant_multiplier_ = &quant_multiplier;
+    conv_param.conv_quant_arg_.input_arg_num_ = 1;
+    conv_param.conv_quant_arg_.filter_arg_num_ = 1;
+    conv_param.conv_quant_arg_.output_arg_num_ = 1;
+    conv_param.conv_quant_arg_.per_channel_ = 0;
+
+    std::vector<int8_t> reference_output;
+    double best_us = std::numeric_limits<double>::max();
+    int best_tile = 0;
+    int best_thread = 0;
+    bool best_optimize = false;
+    for (bool is_optimize : optimize_candidates) {
+      const int unit_size = is_optimize ? UP_ROUND(deep, C4NUM) : UP_ROUND(deep, C16NUM);
+      const int up_round_oc = is_optimize ? UP_ROUND(shape.out_c, C8NUM) : UP_ROUND(shape.out_c, C4NUM);
+      std::vector<int8_t> packed_weight(up_round_oc * unit_size, 0);
+      MATMUL_OPT_R_FUNC matmul_func = nullptr;
+      if (is_optimize) {
+#ifdef ENABLE_ARM64
+        RowMajor2Row8x4MajorInt8(origin_weight.data(), packed_weight.data(), shape.out_c, deep);
+        matmul_func = MatMulRInt8_optimize_handler;
+#endif
+      } else {
+        RowMajor2Row16x4MajorInt8(origin_weight.data(), packed_weight.data(), shape.out_c, deep);
+      }
+      for (int tile_num : tile_candidates) {
+        for (int thread_num : thread_candidates) {
+          conv_param.tile_num_ = tile_num;
+          conv_param.thread_num_ = thread_num;
+          std::vector<int8_t> packed_input(unit_size * tile_num * thread_num, 0);
+          std::vector<int8_t> matmul_input(deep * tile_num * thread_num, 0);
+          std::vector<int32_t> input_sum(tile_num * thread_num, 0);
+          std::vector<int8_t> output_data(out_h * out_w * shape.out_c, 0);
+
+          auto run_task = [&](int task_id) {
+            ConvInt8(input_data.data(), packed_input.data(), matmul_input.data(), packed_weight.data(),
+                     bias_data.data(), output_data.data(), filter_zp.data(), input_sum.data(), task_id, &conv_param,
+                     matmul_func, is_optimize);
+          };
+
+          // Tasks 1..thread_num-1 live on workers spawned before timing; task 0 runs on this thread.
+          // Each repeat bumps generation to release the workers and waits until pending drops to 0.
+          std::mutex mutex;
+          std::condition_variable start_cv;
+          std::condition_variable done_cv;
+          int generation = 0;
+          int pending = 0;
+          bool stop = false;
+          std::vector<std::thread> workers;
+          for (int task_id = 1; task_id < thread_num; ++task_id) {
+            workers.emplace_back([&, task_id]() {
+              int seen = 0;
+              while (true) {
+                {
+                  std::unique_lock<std::mutex> lock(mutex);
+                  start_cv.wait(lock, [&]() { return stop || generation != seen; });
+                  if (stop) {
+                    return;
+                  }
+                  seen = generation;
+                }
+                run_task(task_id);
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--pending == 0) {
+                  done_cv.notify_one();
+                }
+              }
+            });
+          }
+
+          double candidate_us = std::numeric_limits<double>::max();
+          for (int r = 0; r < repeat; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            {
+              std::lock_guard<std::mutex> lock(mutex);
+              pending = thread_num - 1;
+              generation++;
+            }
+            start_cv.notify_all();
+            run_task(0);
+            {
+              std::unique_lock<std::mutex> lock(mutex);
+              done_cv.wait(lock, [&]() { return pending == 0; });
+            }
+            auto end = std::chrono::steady_clock::now();
+            candidate_us = std::min(candidate_us, std::chrono::duration<double, std::micro>(end - start).count());
+          }
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+          }
+          start_cv.notify_all();
+          for (auto &worker : workers) {
+            worker.join();
+          }
+
+          // Tuning may only change speed, never the result
+          if (reference_output.empty()) {
+            reference_output = output_data;
+          } else {
+            ASSERT_EQ(output_data, reference_output) << "tile_num=" << tile_num << " thread_num=" << thread_num
+                                                     << " is_optimize=" << is_optimize;
+          }
+          if (candidate_us < best_us) {
+            best_us = candidate_us;
+            best_tile = tile_num;
+            best_thread = thread_num;
+            best_optimize = is_optimize;
+          }
+        }
+      }
+    }
+
+    std::ostringstream key;
+    key << shape.in_h << "x" << shape.in_w << "x" << shape.in_c << "_" << shape.out_c << "_" << shape.kernel << "x"
+        << shape.kernel << "_s" << shape.stride;
+    std::cout << "ConvInt8Test-ConvInt8_tile_thread_tuning " << key.str() << ": tile_num=" << best_tile
+              << " thread_num=" << best_thread << " is_optimize=" << best_optimize << " (" << best_us << " us)"
+              << std::endl;
+    std::ostringstream value;
+    value << best_tile << " " << best_thread << " " << best_optimize;
+    set_cache_entry(host_key + " " + key.str(), value.str());
+  }
+
+  if (cache_path != nullptr) {
+    std::ofstream cache(cache_path, std::ios::trunc);
+    ASSERT_TRUE(cache.good()) << "cannot write " << cache_path;
+    for (const auto &entry : cache_entries) {
+      cache << entry.first << " " << entry.second << "\n";
+    }
+  }
+}
+
+// Testcase6: ConvInt8 with requests stacked along input_batch_
+// Input: 3 requests of 1x4x4x8, out_c=6, kernel=3x3, pad=1
+// One input_batch_=3 call must return, per batch, exactly what a batch-1 call returns.
+TEST_F(ConvInt8Test, ConvInt8_stacked_batch) {
+  const int request_num = 3;
+  const int in_h = 4;
+  const int in_w = 4;
+  const int in_c = 8;
+  const int out_c = 6;
+  const int kernel_h = 3;
+  const int kernel_w = 3;
+  const int out_h = 4;
+  const int out_w = 4;
+  const int kernel_plane = kernel_h * kernel_w;
+  const int deep = kernel_plane * in_c;
+  const int tile_num = 4;
+  const int thread_num = 2;
+  const int unit_size = UP_ROUND(deep, C16NUM);  // UP_ROUND(72, 16) = 80
+  const int up_round_oc = UP_ROUND(out_c, C4NUM);  // UP_ROUND(6, 4) = 8
+
+  // Stacked input: [3, 4, 4, 8] -> NHWC format, one request per batch
+  std::vector<int8_t> input_data(request_num * in_h * in_w * in_c);
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    input_data[i] = static_cast<int8_t>(static_cast<int>(i * 23 % 127) - 63);
+  }
+  std::vector<int8_t> origin_weight(out_c * deep);
+  for (size_t i = 0; i < origin_weight.size(); ++i) {
+    origin_weight[i] = static_cast<int8_t>(static_cast<int>(i * 5 % 13) - 6);
+  }
+  std::vector<int8_t> packed_weight(up_round_oc * unit_size, 0);
+  RowMajor2Row16x4MajorInt8(origin_weight.data(), packed_weight.data(), out_c, deep);
+  std::vector<int32_t> bias_data = {0, 10, -10, 20, -20, 30};
+  std::vector<int32_t> filter_zp(out_c, 0);
+
+  // Per-layer quantization
+  QuantArg input_quant_arg = {0.5f, 0};
+  QuantArg filter_quant_args = {0.01f, 0};
+  QuantArg output_quant_arg = {0.5f, -2};
+  int32_t out_act_min = -128;
+  int32_t out_act_max = 127;
+  int32_t left_shift = 0;
+  int32_t right_shift = -7;
+  int32_t quant_multiplier = 1073741824;
+
+  auto run_conv = [&](int batch, int8_t *input, int8_t *output) {
+    ConvParameter conv_param;
+    memset(&conv_param, 0, sizeof(ConvParameter));
+    conv_param.input_batch_ = batch;
+    conv_param.input_h_ = in_h;
+    conv_param.input_w_ = in_w;
+    conv_param.input_channel_ = in_c;
+    conv_param.output_batch_ = batch;
+    conv_param.output_h_ = out_h;
+    conv_param.output_w_ = out_w;
+    conv_param.output_channel_ = out_c;
+    conv_param.kernel_h_ = kernel_h;
+    conv_param.kernel_w_ = kernel_w;
+    conv_param.stride_h_ = 1;
+    conv_param.stride_w_ = 1;
+    conv_param.pad_u_ = 1;
+    conv_param.pad_d_ = 1;
+    conv_param.pad_l_ = 1;
+    conv_param.pad_r_ = 1;
+    conv_param.dilation_h_ = 1;
+    conv_param.dilation_w_ = 1;
+    conv_param.group_ = 1;
+    conv_param.tile_num_ = tile_num;
+    conv_param.thread_num_ = thread_num;
+    conv_param.conv_quant_arg_.input_quant_args_ = &input_quant_arg;
+    conv_param.conv_quant_arg_.filter_quant_args_ = &filter_quant_args;
+    conv_param.conv_quant_arg_.output_quant_args_ = &output_quant_arg;
+    conv_param.conv_quant_arg_.out_act_min_ = &out_act_min;
+    conv_param.conv_quant_arg_.out_act_max_ = &out_act_max;
+    conv_param.conv_quant_arg_.left_shift_ = &left_shift;
+    conv_param.conv_quant_arg_.right_shift_ = &right_shift;
+    conv_param.conv_quant_arg_.quant_multiplier_ = &quant_multiplier;
+    conv_param.conv_quant_arg_.input_arg_num_ = 1;
+    conv_param.conv_quant_arg_.filter_arg_num_ = 1;
+    conv_param.conv_quant_arg_.output_arg_num_ = 1;
+    conv_param.conv_quant_arg_.per_channel_ = 0;
+
+    std::vector<int8_t> packed_input(unit_size * tile_num * thread_num, 0);
+    std::vector<int8_t> matmul_input(deep * tile_num * thread_num, 0);
+    std::vector<int32_t> input_sum(tile_num * thread_num, 0);
+    for (int task_id = 0; task_id < thread_num; ++task_id) {
+      ConvInt8(input, packed_input.data(), matmul_input.data(), packed_weight.data(), bias_data.data(), output,
+               filter_zp.data(), input_sum.data(), task_id, &conv_param, nullptr, false);
+    }
+  };
+
+  const int in_batch_size = in_h * in_w * in_c;
+  const int out_batch_size = out_h * out_w * out_c;
+  std::vector<int8_t> stacked_output(request_num * out_batch_size, 0);
+  run_conv(request_num, input_data.data(), stacked_output.data());
+
+  for (int r = 0; r < request_num; ++r) {
+    std::vector<int8_t> single_output(out_batch_size, 0);
+    run_conv(1, input_data.data() + r * in_batch_size, single_output.data());
+    std::cout << "ConvInt8Test-ConvInt8_stacked_batch request " << r << " output:\n";
+    for (int i = 0; i < out_batch_size; ++i) {
+      std::cout << static_cast<int32_t>(single_output[i]) << ", ";
+    }
+    std::cout << std::endl;
+    for (int i = 0; i < out_batch_size; ++i) {
+      EXPECT_EQ(stacked_output[r * out_batch_size + i], single_output[i]) << "request " << r << " index " << i;
+    }
+  }
+}
+
+// Testcase7: ConvInt8 with per-task scratch at unrelated bases
+// Input: batch=1, h=16, w=16, in_c=16, out_c=24, kernel=3x3, pad=1, 4 tasks
+// ConvInt8 addresses its scratch as base + task_id * slice, so a runtime may give every task its own
+// storage (e.g. allocated and first-touched by the worker that runs it) instead of slices of one block.
+// Each worker here owns separate heap storage of task_id + 1 slices, filled with a sentinel, and passes
+// its start as the base. Only the task's own slice may be written, and the output must equal a
+// single-threaded run.
+TEST_F(ConvInt8Test, ConvInt8_per_task_scratch_bases) {
+  const int in_h = 16;
+  const int in_w = 16;
+  const int in_c = 16;
+  const int out_c = 24;
+  const int kernel_h = 3;
+  const int kernel_w = 3;
+  const int out_h = 16;
+  const int out_w = 16;
+  const int kernel_plane = kernel_h * kernel_w;
+  const int deep = kernel_plane * in_c;
+  const int tile_num = 8;
+  const int unit_size = UP_ROUND(deep, C16NUM);  // UP_ROUND(144, 16) = 144
+  const int up_round_oc = UP_ROUND(out_c, C4NUM);  // UP_ROUND(24, 4) = 24
+  const int input_sum_offset = tile_num * up_round_oc;
+  const int thread_num = 4;
+
+  std::vector<int8_t> input_data(in_h * in_w * in_c);
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    input_data[i] = static_cast<int8_t>(static_cast<int>(i * 19 % 251) - 125);
+  }
+  std::vector<int8_t> origin_weight(out_c * deep);
+  for (size_t i = 0; i < origin_weight.size(); ++i) {
+    origin_weight[i] = static_cast<int8_t>(static_cast<int>(i * 11 % 31) - 15);
+  }
+  std::vector<int8_t> packed_weight(up_round_oc * unit_size, 0);
+  RowMajor2Row16x4MajorInt8(origin_weight.data(), packed_weight.data(), out_c, deep);
+  std::vector<int32_t> bias_data(out_c);
+  for (int oc = 0; oc < out_c; ++oc) {
+    bias_data[oc] = oc * 50 - 600;
+  }
+  std::vector<int32_t> filter_zp(out_c, 0);
+
+  // Per-channel quantization
+  QuantArg input_quant_arg = {0.5f, 0};
+  std::vector<QuantArg> filter_quant_args(out_c, {0.01f, 0});
+  QuantArg output_quant_arg = {0.5f, 1};
+  int32_t out_act_min = -128;
+  int32_t out_act_max = 127;
+  std::vector<int32_t> left_shift(out_c, 0);
+  std::vector<int32_t> right_shift(out_c);
+  std::vector<int32_t> quant_multiplier(out_c);
+  for (int oc = 0; oc < out_c; ++oc) {
+    right_shift[oc] = -9 - oc % 2;
+    quant_multiplier[oc] = 1073741824 + oc * 20000000;
+  }
+
+  auto make_param = [&](int threads) {
+    ConvParameter conv_param;
+    memset(&conv_param, 0, sizeof(ConvParameter));
+    conv_param.input_batch_ = 1;
+    conv_param.input_h_ = in_h;
+    conv_param.input_w_ = in_w;
+    conv_param.input_channel_ = in_c;
+    conv_param.output_batch_ = 1;
+    conv_param.output_h_ = out_h;
+    conv_param.output_w_ = out_w;
+    conv_param.output_channel_ = out_c;
+    conv_param.kernel_h_ = kernel_h;
+    conv_param.kernel_w_ = kernel_w;
+    conv_param.stride_h_ = 1;
+    conv_param.stride_w_ = 1;
+    conv_param.pad_u_ = 1;
+    conv_param.pad_d_ = 1;
+    conv_param.pad_l_ = 1;
+    conv_param.pad_r_ = 1;
+    conv_param.dilation_h_ = 1;
+    conv_param.dilation_w_ = 1;
+    conv_param.group_ = 1;
+    conv_param.tile_num_ = tile_num;
+    conv_param.thread_num_ = threads;
+    conv_param.conv_quant_arg_.input_quant_args_ = &input_quant_arg;
+    conv_param.conv_quant_arg_.filter_quant_args_ = filter_quant_args.data();
+    conv_param.conv_quant_arg_.output_quant_args_ = &output_quant_arg;
+    conv_param.conv_quant_arg_.out_act_min_ = &out_act_min;
+    conv_param.conv_quant_arg_.out_act_max_ = &out_act_max;
+    conv_param.conv_quant_arg_.left_shift_ = left_shift.data();
+    conv_param.conv_quant_arg_.right_shift_ = right_shift.data();
+    conv_param.conv_quant_arg_.quant_multiplier_ = quant_multiplier.data();
+    conv_param.conv_quant_arg_.input_arg_num_ = 1;
+    conv_param.conv_quant_arg_.filter_arg_num_ = out_c;
+    conv_param.conv_quant_arg_.output_arg_num_ = 1;
+    conv_param.conv_quant_arg_.per_channel_ = FILTER_PER_CHANNEL;
+    return conv_param;
+  };
+
+  // Single-threaded reference
+  ConvParameter serial_param = make_param(1);
+  std::vector<int8_t> serial_packed_input(unit_size * tile_num, 0);
+  std::vector<int8_t> serial_matmul_input(deep * tile_num, 0);
+  std::vector<int32_t> serial_input_sum(input_sum_offset, 0);
+  std::vector<int8_t> benchmark(out_h * out_w * out_c, 0);
+  ConvInt8(input_data.data(), serial_packed_input.data(), serial_matmul_input.data(), packed_weight.data(),
+           bias_data.data(), benchmark.data(), filter_zp.data(), serial_input_sum.data(), 0, &serial_param, nullptr,
+           false);
+
+  const int8_t sentinel = 0x5A;
+  const int32_t sum_sentinel = 0x5A5A5A5A;
+  const size_t packed_input_slice = unit_size * tile_num;
+  const size_t matmul_input_slice = deep * tile_num;
+  std::vector<std::vector<int8_t>> packed_input(thread_num);
+  std::vector<std::vector<int8_t>> matmul_input(thread_num);
+  std::vector<std::vector<int32_t>> input_sum(thread_num);
+  ConvParameter conv_param = make_param(thread_num);
+  std::vector<int8_t> output_data(out_h * out_w * out_c, 0);
+  std::vector<std::thread> workers;
+  for (int task_id = 0; task_id < thread_num; ++task_id) {
+    workers.emplace_back([&, task_id]() {
+      packed_input[task_id].assign((task_id + 1) * packed_input_slice, sentinel);
+      matmul_input[task_id].assign((task_id + 1) * matmul_input_slice, sentinel);
+      input_sum[task_id].assign((task_id + 1) * input_sum_offset, sum_sentinel);
+      std::fill(packed_input[task_id].begin() + task_id * packed_input_slice, packed_input[task_id].end(), 0);
+      std::fill(matmul_input[task_id].begin() + task_id * matmul_input_slice, matmul_input[task_id].end(), 0);
+      std::fill(input_sum[task_id].begin() + task_id * input_sum_offset, input_sum[task_id].end(), 0);
+      ConvInt8(input_data.data(), packed_input[task_id].data(), matmul_input[task_id].data(), packed_weight.data(),
+               bias_data.data(), output_data.data(), filter_zp.data(), input_sum[task_id].data(), task_id,
+               &conv_param, nullptr, false);
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  // Everything below the task's own slice belongs to lower task ids and must be untouched
+  for (int task_id = 1; task_id < thread_num; ++task_id) {
+    for (size_t i = 0; i < task_id * packed_input_slice; ++i) {
+      ASSERT_EQ(packed_input[task_id][i], sentinel) << "task " << task_id << " packed_input[" << i << "]";
+    }
+    for (size_t i = 0; i < task_id * matmul_input_slice; ++i) {
+      ASSERT_EQ(matmul_input[task_id][i], sentinel) << "task " << task_id << " matmul_input[" << i << "]";
+    }
+    for (int i = 0; i < task_id * input_sum_offset; ++i) {
+      ASSERT_EQ(input_sum[task_id][i], sum_sentinel) << "task " << task_id << " input_sum[" << i << "]";
+    }
+  }
+
+  for (size_t i = 0; i < output_data.size(); ++i) {
+    EXPECT_EQ(output_data[i], benchmark[i]) << "Mismatch at index " << i;
+  }
+}
+
+// Testcase8: ConvInt8 with the requant params in an aligned per-channel requant plan
+// Input: batch=1, h=4, w=4, in_c=8, out_c=12, kernel=1x1
+// The plan is one allocation of five int32 rows (multiplier, left shift, right shift, act min, act max),
+// each padded to a C8NUM channel block and aligned to one so a block load never straddles two rows;
+// padded entries repeat the last real channel. Broadcasting the per-layer params into the plan and
+// running with FILTER_PER_CHANNEL must be bit-exact with the per-layer path. A plan with per-channel
+// distinct multipliers/shifts is checked against a scalar reference. ConvInt8 clamps with
+// out_act_min_[0]/out_act_max_[0] only, so for this kernel the act rows repeat one value (ConvDwInt8SW
+// reads them per channel, see ConvDwInt8SW_RequantPlanPerChannel).
+TEST_F(ConvInt8Test, ConvInt8_requant_plan_broadcast) {
+  const int in_h = 4;
+  const int in_w = 4;
+  const int in_c = 8;
+  const int out_c = 12;
+  const int out_h = 4;
+  const int out_w = 4;
+  const int deep = in_c;
+  const int tile_num = 4;
+  const int unit_size = UP_ROUND(deep, C16NUM);  // UP_ROUND(8, 16) = 16
+  const int up_round_oc = UP_ROUND(out_c, C4NUM);  // UP_ROUND(12, 4) = 12
+  const int plan_channel = UP_ROUND(out_c, C8NUM);  // UP_ROUND(12, 8) = 16
+
+  std::vector<int8_t> input_data(in_h * in_w * in_c);
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    input_data[i] = static_cast<int8_t>(static_cast<int>(i * 43 % 255) - 127);
+  }
+  std::vector<int8_t> origin_weight(out_c * deep);
+  for (size_t i = 0; i < origin_weight.size(); ++i) {
+    origin_weight[i] = static_cast<int8_t>(static_cast<int>(i * 29 % 97) - 48);
+  }
+  std::vector<int8_t> packed_weight(up_round_oc * unit_size, 0);
+  RowMajor2Row16x4MajorInt8(origin_weight.data(), packed_weight.data(), out_c, deep);
+  std::vector<int32_t> bias_data(out_c);
+  for (int oc = 0; oc < out_c; ++oc) {
+    bias_data[oc] = oc * 97 - 500;
+  }
+  std::vector<int32_t> filter_zp(out_c, 0);
+
+  // Per-layer quantization
+  QuantArg input_quant_arg = {0.5f, 0};
+  QuantArg filter_quant_args = {0.01f, 0};
+  QuantArg output_quant_arg = {0.5f, -3};
+  int32_t out_act_min = -100;
+  int32_t out_act_max = 110;
+  int32_t left_shift = 1;
+  int32_t right_shift = -9;
+  int32_t quant_multiplier = 1518500250;
+  std::vector<QuantArg> plan_filter_args(plan_channel, filter_quant_args);
+
+  enum PlanRow { kMultiplier, kLeftShift, kRightShift, kActMin, kActMax, kPlanRows };
+  const size_t plan_align = C8NUM * sizeof(int32_t);
+  auto build_plan = [&](const std::vector<std::vector<int32_t>> &rows) {
+    void *memory = nullptr;
+    EXPECT_EQ(posix_memalign(&memory, plan_align, kPlanRows * plan_channel * sizeof(int32_t)), 0);
+    std::unique_ptr<int32_t, decltype(&free)> plan(static_cast<int32_t *>(memory), &free);
+    for (int row = 0; row < kPlanRows; ++row) {
+      for (int c = 0; c < plan_channel; ++c) {
+        plan.get()[row * plan_channel + c] = rows[row][MSMIN(c, out_c - 1)];
+      }
+    }
+    return plan;
+  };
+  auto check_plan_layout = [&](const int32_t *plan) {
+    for (int row = 0; row < kPlanRows; ++row) {
+      const int32_t *row_data = plan + row * plan_channel;
+      ASSERT_EQ(reinterpret_cast<uintptr_t>(row_data) % plan_align, 0u) << "row " << row;
+      for (int c = out_c; c < plan_channel; ++c) {
+        ASSERT_EQ(row_data[c], row_data[out_c - 1]) << "row " << row << " padding " << c;
+      }
+    }
+    // Only act_min[0]/act_max[0] reach the output here; a varying act row would be silently ignored
+    for (int row = kActMin; row <= kActMax; ++row) {
+      for (int c = 0; c < plan_channel; ++c) {
+        ASSERT_EQ(plan[row * plan_channel + c], plan[row * plan_channel]) << "row " << row << " channel " << c;
+      }
+    }
+  };
+
+  auto run_conv = [&](const int32_t *plan, int8_t *output) {
+    ConvParameter conv_param;
+    memset(&conv_param, 0, sizeof(ConvParameter));
+    conv_param.input_batch_ = 1;
+    conv_param.input_h_ = in_h;
+    conv_param.input_w_ = in_w;
+    conv_param.input_channel_ = in_c;
+    conv_param.output_batch_ = 1;
+    conv_param.output_h_ = out_h;
+    conv_param.output_w_ = out_w;
+    conv_param.output_channel_ = out_c;
+    conv_param.kernel_h_ = 1;
+    conv_param.kernel_w_ = 1;
+    conv_param.stride_h_ = 1;
+    conv_param.stride_w_ = 1;
+    conv_param.dilation_h_ = 1;
+    conv_param.dilation_w_ = 1;
+    conv_param.group_ = 1;
+    conv_param.tile_num_ = tile_num;
+    conv_param.thread_num_ = 1;
+    conv_param.conv_quant_arg_.input_quant_args_ = &input_quant_arg;
+    conv_param.conv_quant_arg_.output_quant_args_ = &output_quant_arg;
+    conv_param.conv_quant_arg_.input_arg_num_ = 1;
+    conv_param.conv_quant_arg_.output_arg_num_ = 1;
+    if (plan != nullptr) {
+      conv_param.conv_quant_arg_.filter_quant_args_ = plan_filter_args.data();
+      conv_param.conv_quant_arg_.quant_multiplier_ = const_cast<int32_t *>(plan + kMultiplier * plan_channel);
+      conv_param.conv_quant_arg_.left_shift_ = const_cast<int32_t *>(plan + kLeftShift * plan_channel);
+      conv_param.conv_quant_arg_.right_shift_ = const_cast<int32_t *>(plan + kRightShift * plan_channel);
+      conv_param.conv_quant_arg_.out_act_min_ = const_cast<int32_t *>(plan + kActMin * plan_channel);
+      conv_param.conv_quant_arg_.out_act_max_ = const_cast<int32_t *>(plan + kActMax * plan_channel);
+      conv_param.conv_quant_arg_.filter_arg_num_ = out_c;
+      conv_param.conv_quant_arg_.per_channel_ = FILTER_PER_CHANNEL;
+    } else {
+      conv_param.conv_quant_arg_.filter_quant_args_ = &filter_quant_args;
+      conv_param.conv_quant_arg_.out_act_min_ = &out_act_min;
+      conv_param.conv_quant_arg_.out_act_max_ = &out_act_max;
+      conv_param.conv_quant_arg_.left_shift_ = &left_shift;
+      conv_param.conv_quant_arg_.right_shift_ = &right_shift;
+      conv_param.conv_quant_arg_.quant_multiplier_ = &quant_multiplier;
+      conv_param.conv_quant_arg_.filter_arg_num_ = 1;
+      conv_param.conv_quant_arg_.per_channel_ = 0;
+    }
+    std::vector<int8_t> packed_input(unit_size * tile_num, 0);
+    std::vector<int8_t> matmul_input(deep * tile_num, 0);
+    std::vector<int32_t> input_sum(tile_num * up_round_oc, 0);
+    ConvInt8(input_data.data(), packed_input.data(), matmul_input.data(), packed_weight.data(), bias_data.data(),
+             output, filter_zp.data(), input_sum.data(), 0, &conv_param, nullptr, false);
+  };
+
+  // Broadcast plan: every row repeats the per-layer value
+  auto broadcast_plan =
+    build_plan({std::vector<int32_t>(out_c, quant_multiplier), std::vector<int32_t>(out_c, left_shift),
+                std::vector<int32_t>(out_c, right_shift), std::vector<int32_t>(out_c, out_act_min),
+                std::vector<int32_t>(out_c, out_act_max)});
+  check_plan_layout(broadcast_plan.get());
+  std::vector<int8_t> per_layer_output(out_h * out_w * out_c, 0);
+  std::vector<int8_t> plan_output(out_h * out_w * out_c, 0);
+  run_conv(nullptr, per_layer_output.data());
+  run_conv(broadcast_plan.get(), plan_output.data());
+
+  std::cout << "ConvInt8Test-ConvInt8_requant_plan_broadcast output:\n";
+  for (size_t i = 0; i < plan_output.size(); ++i) {
+    std::cout << static_cast<int32_t>(plan_output[i]) << ", ";
+  }
+  std::cout << std::endl;
+
+  for (size_t i = 0; i < plan_output.size(); ++i) {
+    EXPECT_EQ(plan_output[i], per_layer_output[i]) << "Mismatch at index " << i;
+  }
+
+  // Per-channel plan: distinct multiplier/shifts per channel, act range tight enough to clamp
+  std::vector<int32_t> channel_multiplier(out_c);
+  std::vector<int32_t> channel_left_shift(out_c);
+  std::vector<int32_t> channel_right_shift(out_c);
+  for (int oc = 0; oc < out_c; ++oc) {
+    channel_multiplier[oc] = 1073741824 + oc * 60000000;
+    channel_left_shift[oc] = oc % 2;
+    channel_right_shift[oc] = -8 - oc % 3;
+  }
+  const int32_t channel_act_min = -15;
+  const int32_t channel_act_max = 18;
+  auto channel_plan = build_plan({channel_multiplier, channel_left_shift, channel_right_shift,
+                                  std::vector<int32_t>(out_c, channel_act_min),
+                                  std::vector<int32_t>(out_c, channel_act_max)});
+  check_plan_layout(channel_plan.get());
+  std::vector<int8_t> channel_output(out_h * out_w * out_c, 0);
+  run_conv(channel_plan.get(), channel_output.data());
+
+  int clamped = 0;
+  int differs_from_broadcast = 0;
+  for (int p = 0; p < out_h * out_w; ++p) {
+    for (int oc = 0; oc < out_c; ++oc) {
+      int32_t acc = bias_data[oc];
+      for (int ic = 0; ic < in_c; ++ic) {
+        acc += input_data[p * in_c + ic] * origin_weight[oc * deep + ic];
+      }
+      int32_t value = MultiplyByQuantizedMultiplier(acc, channel_multiplier[oc], channel_left_shift[oc],
+                                                    channel_right_shift[oc]) +
+                      output_quant_arg.zp_;
+      if (value < channel_act_min || value > channel_act_max) {
+        clamped++;
+      }
+      value = MSMIN(channel_act_max, MSMAX(channel_act_min, value));
+      const int index = p * out_c + oc;
+      EXPECT_EQ(channel_output[index], static_cast<int8_t>(value)) << "per-channel plan mismatch at index " << index;
+      if (channel_output[index] != plan_output[index]) {
+        differs_from_broadcast++;
+      }
+    }
+  }
+  // Without clamped pixels the act rows go untested, and without a change from the broadcast run the
+  // per-channel multiplier/shift rows do
+  EXPECT_GT(clamped, 0);
+  EXPECT_GT(differs_from_broadcast, 0);
+}
@@ -0,0 +1,578 @@
+// Differential fuzzing and performance-regression harness for the int8 convolution kernels.
+// Random ConvParameter/SlidingWindowParam/quant configurations are generated from a fixed seed
+// (so a failure reproduces by rerunning the case) and pushed through ConvInt8, ConvDwInt8SW and
+// ConvDw3x3Int8 + ConvDw3x3Int8Pad. Every output is compared bit-exactly against a scalar
+// reference. Wall time per kernel is summed and compared with the baseline file named by
+// MSLITE_INT8_FUZZ_BASELINE; set MSLITE_INT8_FUZZ_UPDATE_BASELINE=1 to rewrite it instead.
+// Zero points of input and filter are kept at 0 for ConvInt8 (its kernel wrapper folds them into
+// input_sum/bias before the call). Filter zero points are already subtracted from the int16 depthwise
+// weights, but ConvDw3x3Int8/ConvDw3x3Int8Pad read input_quant_args_[0].zp_ themselves, so their
+// input zero point is fuzzed.
+namespace {
+constexpr uint32_t kFuzzSeed = 20201019;
+constexpr int kFuzzIterations = 64;
+constexpr double kBaselineTolerance = 1.3;
+
+int RandInt(std::mt19937 *rng, int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(*rng); }
+
+struct FuzzQuant {
+  std::vector<int32_t> quant_multiplier;
+  std::vector<int32_t> left_shift;
+  std::vector<int32_t> right_shift;
+  std::vector<int32_t> out_act_min;
+  std::vector<int32_t> out_act_max;
+  int32_t output_zp;
+  bool per_channel;
+};
+
+// Arrays are always sized per channel; per-layer configs broadcast entry 0 so both the kernels that
+// index by channel and the ones that read [0] see the same parameters.
+FuzzQuant RandomQuant(std::mt19937 *rng, int channel) {
+  FuzzQuant quant;
+  quant.per_channel = RandInt(rng, 0, 1) == 1;
+  quant.output_zp = RandInt(rng, -20, 20);
+  int32_t act_min = RandInt(rng, 0, 3) == 0 ? RandInt(rng, -128, -1) : -128;
+  int32_t act_max = RandInt(rng, 0, 3) == 0 ? RandInt(rng, 0, 127) : 127;
+  for (int c = 0; c < channel; c++) {
+    if (c == 0 || quant.per_channel) {
+      quant.quant_multiplier.push_back(RandInt(rng, 1 << 30, INT32_MAX));
+      quant.left_shift.push_back(RandInt(rng, 0, 1));
+      quant.right_shift.push_back(RandInt(rng, -12, -4));
+    } else {
+      quant.quant_multiplier.push_back(quant.quant_multiplier[0]);
+      quant.left_shift.push_back(quant.left_shift[0]);
+      quant.right_shift.push_back(quant.right_shift[0]);
+    }
+    quant.out_act_min.push_back(act_min);
+    quant.out_act_max.push_back(act_max);
+  }
+  return quant;
+}
+
+void SetConvQuantArg(ConvParameter *conv_param, FuzzQuant *quant, QuantArg *input_arg, QuantArg *filter_args,
+                     QuantArg *output_arg) {
+  conv_param->conv_quant_arg_.input_quant_args_ = input_arg;
+  conv_param->conv_quant_arg_.filter_quant_args_ = filter_args;
+  conv_param->conv_quant_arg_.output_quant_args_ = output_arg;
+  conv_param->conv_quant_arg_.quant_multiplier_ = quant->quant_multiplier.data();
+  conv_param->conv_quant_arg_.left_shift_ = quant->left_shift.data();
+  conv_param->conv_quant_arg_.right_shift_ = quant->right_shift.data();
+  conv_param->conv_quant_arg_.out_act_min_ = quant->out_act_min.data();
+  conv_param->conv_quant_arg_.out_act_max_ = quant->out_act_max.data();
+  conv_param->conv_quant_arg_.input_arg_num_ = 1;
+  conv_param->conv_quant_arg_.filter_arg_num_ = quant->per_channel ? quant->quant_multiplier.size() : 1;
+  conv_param->conv_quant_arg_.output_arg_num_ = 1;
+  conv_param->conv_quant_arg_.per_channel_ = quant->per_channel ? FILTER_PER_CHANNEL : 0;
+}
+
+int8_t RequantRef(int32_t acc, const FuzzQuant &quant, int32_t output_zp, int c) {
+  int32_t value = MultiplyByQuantizedMultiplier(acc, quant.quant_multiplier[c], quant.left_shift[c],
+                                                quant.right_shift[c]) +
+                  output_zp;
+  value = MSMIN(quant.out_act_max[c], MSMAX(quant.out_act_min[c], value));
+  return static_cast<int8_t>(value);
+}
+
+// Shared scalar depthwise reference; weight(c, kh, kw) hides the kernel-specific packing.
+std::vector<int8_t> DepthwiseInt8Ref(const std::vector<int8_t> &input, const ConvParameter &conv_param,
+                                     const std::function<int32_t(int, int, int)> &weight,
+                                     const std::vector<int32_t> &bias, const std::vector<int8_t> &input_zp,
+                                     const std::vector<int32_t> &output_zp, const FuzzQuant &quant) {
+  const int channel = conv_param.output_channel_;
+  std::vector<int8_t> output(conv_param.output_batch_ * conv_param.output_h_ * conv_param.output_w_ * channel);
+  for (int b = 0; b < conv_param.output_batch_; b++) {
+    for (int oh = 0; oh < conv_param.output_h_; oh++) {
+      for (int ow = 0; ow < conv_param.output_w_; ow++) {
+        for (int c = 0; c < channel; c++) {
+          int32_t acc = 0;
+          for (int kh = 0; kh < conv_param.kernel_h_; kh++) {
+            for (int kw = 0; kw < conv_param.kernel_w_; kw++) {
+              int ih = oh * conv_param.stride_h_ - conv_param.pad_u_ + kh * conv_param.dilation_h_;
+              int iw = ow * conv_param.stride_w_ - conv_param.pad_l_ + kw * conv_param.dilation_w_;
+              if (ih < 0 || ih >= conv_param.input_h_ || iw < 0 || iw >= conv_param.input_w_) {
+                continue;
+              }
+              int in_index = ((b * conv_param.input_h_ + ih) * conv_param.input_w_ + iw) * channel + c;
+              acc += (input[in_index] - input_zp[c]) * weight(c, kh, kw);
+            }
+          }
+          acc += bias[c];
+          output[((b * conv_param.output_h_ + oh) * conv_param.output_w_ + ow) * channel + c] =
+            RequantRef(acc, quant, output_zp[c], c);
+        }
+      }
+    }
+  }
+  return output;
+}
+
+// Same border/center split as InitSlidingParamConvDw with an 8-channel block. left/top are clamped
+// to the output size and right/bottom never shrink past them, so narrow outputs (where the padded
+// kernel never fits) get an empty center instead of a negative right/bottom.
+SlidingWindowParam DepthwiseSliding(const ConvParameter &conv_param) {
+  SlidingWindowParam sliding;
+  memset(&sliding, 0, sizeof(SlidingWindowParam));
+  int left = 0;
+  while (left * conv_param.stride_w_ < conv_param.pad_l_ && left < conv_param.output_w_) left++;
+  int right = conv_param.output_w_;
+  while ((right - 1) * conv_param.stride_w_ - conv_param.pad_l_ + conv_param.kernel_w_ * conv_param.dilation_w_ >
+           conv_param.input_w_ &&
+         right > left) {
+    right--;
+  }
+  int top = 0;
+  while (top * conv_param.stride_h_ < conv_param.pad_u_ && top < conv_param.output_h_) top++;
+  int bottom = conv_param.output_h_;
+  while ((bottom - 1) * conv_param.stride_h_ - conv_param.pad_u_ + conv_param.kernel_h_ * conv_param.dilation_h_ >
+           conv_param.input_h_ &&
+         bottom > top) {
+    bottom--;
+  }
+  sliding.left_ = left;
+  sliding.right_ = right;
+  sliding.top_ = top;
+  sliding.bottom_ = bottom;
+  sliding.c_block_ = UP_DIV(conv_param.output_channel_, C8NUM);
+  sliding.block_channel_ = sliding.c_block_ * C8NUM;
+  sliding.ic_align_ = sliding.block_channel_;
+  sliding.out_step_ = conv_param.output_h_ * conv_param.output_w_ * sliding.block_channel_;
+  sliding.out_h_step_ = conv_param.output_w_ * sliding.block_channel_;
+  sliding.out_c_step_ = 1;
+  sliding.out_w_step_ = sliding.block_channel_;
+  sliding.in_step_ = conv_param.input_h_ * conv_param.input_w_ * sliding.block_channel_;
+  sliding.in_h_step_ = conv_param.input_w_ * sliding.block_channel_;
+  sliding.in_sh_step_ = sliding.in_h_step_ * conv_param.stride_h_;
+  sliding.in_sw_step_ = sliding.block_channel_ * conv_param.stride_w_;
+  sliding.in_kh_step_ = sliding.in_h_step_ * conv_param.dilation_h_;
+  sliding.in_kw_step_ = sliding.block_channel_ * conv_param.dilation_w_;
+  sliding.kernel_step_ = conv_param.kernel_h_ * conv_param.kernel_w_ * C8NUM;
+  return sliding;
+}
+
+bool SlidingInBounds(const SlidingWindowParam &sliding, const ConvParameter &conv_param) {
+  return 0 <= sliding.left_ && sliding.left_ <= sliding.right_ && sliding.right_ <= conv_param.output_w_ &&
+         0 <= sliding.top_ && sliding.top_ <= sliding.bottom_ && sliding.bottom_ <= conv_param.output_h_;
+}
+
+class KernelTimer {
+ public:
+  template <typename Func>
+  void Record(const std::string &kernel, Func &&func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    total_us_[kernel] += std::chrono::duration<double, std::micro>(end - start).count();
+  }
+
+  // Baseline file format: one "<kernel> <total_us>" pair per line.
+  void CheckBaseline() const {
+    std::map<std::string, double> baseline;
+    const char *path = std::getenv("MSLITE_INT8_FUZZ_BASELINE");
+    if (path != nullptr) {
+      std::ifstream in(path);
+      std::string kernel;
+      double us = 0;
+      while (in >> kernel >> us) {
+        baseline[kernel] = us;
+      }
+    }
+    for (const auto &item : total_us_) {
+      auto iter = baseline.find(item.first);
+      std::cout << "[fuzz timing] " << item.first << ": " << item.second << " us";
+      if (iter != baseline.end() && iter->second > 0) {
+        double ratio = item.second / iter->second;
+        std::cout << " (baseline " << iter->second << " us, ratio " << ratio << ")";
+        if (std::getenv("MSLITE_INT8_FUZZ_UPDATE_BASELINE") == nullptr) {
+          EXPECT_LE(ratio, kBaselineTolerance) << item.first << " is slower than the stored baseline";
+        }
+      }
+      std::cout << std::endl;
+    }
+    if (path != nullptr && std::getenv("MSLITE_INT8_FUZZ_UPDATE_BASELINE") != nullptr) {
+      for (const auto &item : total_us_) {
+        baseline[item.first] = item.second;
+      }
+      std::ofstream out(path);
+      for (const auto &item : baseline) {
+        out << item.first << " " << item.second << "\n";
+      }
+    }
+  }
+
+ private:
+  std::map<std::string, double> total_us_;
+};
+}  // namespace
+
+// Testcase1: ConvInt8 random shapes/quant params, is_optimize=false (and true where the
+// dotprod handler exists), one to three task_ids
+TEST_F(ConvInt8Test, ConvInt8_DiffFuzz) {
+  std::mt19937 rng(kFuzzSeed);
+  KernelTimer timer;
+  for (int iter = 0; iter < kFuzzIterations; iter++) {
+    ConvParameter conv_param;
+    memset(&conv_param, 0, sizeof(ConvParameter));
+    conv_param.input_batch_ = RandInt(&rng, 1, 2);
+    conv_param.input_h_ = RandInt(&rng, 1, 12);
+    conv_param.input_w_ = RandInt(&rng, 1, 12);
+    conv_param.input_channel_ = RandInt(&rng, 1, 20);
+    conv_param.output_channel_ = RandInt(&rng, 1, 20);
+    conv_param.kernel_h_ = RandInt(&rng, 1, 3);
+    conv_param.kernel_w_ = RandInt(&rng, 1, 3);
+    conv_param.stride_h_ = RandInt(&rng, 1, 2);
+    conv_param.stride_w_ = RandInt(&rng, 1, 2);
+    conv_param.dilation_h_ = RandInt(&rng, 1, 2);
+    conv_param.dilation_w_ = RandInt(&rng, 1, 2);
+    conv_param.pad_u_ = RandInt(&rng, 0, conv_param.kernel_h_ / 2);
+    conv_param.pad_d_ = conv_param.pad_u_;
+    conv_param.pad_l_ = RandInt(&rng, 0, conv_param.kernel_w_ / 2);
+    conv_param.pad_r_ = conv_param.pad_l_;
+    int extent_h = (conv_param.kernel_h_ - 1) * conv_param.dilation_h_ + 1;
+    int extent_w = (conv_param.kernel_w_ - 1) * conv_param.dilation_w_ + 1;
+    conv_param.output_h_ = (conv_param.input_h_ + 2 * conv_param.pad_u_ - extent_h) / conv_param.stride_h_ + 1;
+    conv_param.output_w_ = (conv_param.input_w_ + 2 * conv_param.pad_l_ - extent_w) / conv_param.stride_w_ + 1;
+    if (conv_param.output_h_ <= 0 || conv_param.output_w_ <= 0) {
+      continue;
+    }
+    conv_param.output_batch_ = conv_param.input_batch_;
+    conv_param.group_ = 1;
+    conv_param.tile_num_ = RandInt(&rng, 0, 1) == 0 ? C4NUM : C12NUM;
+    conv_param.thread_num_ = RandInt(&rng, 1, 3);
+
+    const int in_c = conv_param.input_channel_;
+    const int out_c = conv_param.output_channel_;
+    const int deep = conv_param.kernel_h_ * conv_param.kernel_w_ * in_c;
+    const int out_plane = conv_param.output_h_ * conv_param.output_w_;
+    std::vector<int8_t> input(conv_param.input_batch_ * conv_param.input_h_ * conv_param.input_w_ * in_c);
+    for (auto &value : input) value = static_cast<int8_t>(RandInt(&rng, -128, 127));
+    std::vector<int8_t> origin_weight(out_c * deep);
+    for (auto &value : origin_weight) value = static_cast<int8_t>(RandInt(&rng, -127, 127));
+    std::vector<int32_t> bias(out_c);
+    for (auto &value : bias) value = RandInt(&rng, -20000, 20000);
+    std::vector<int32_t> filter_zp(out_c, 0);
+    FuzzQuant quant = RandomQuant(&rng, out_c);
+    QuantArg input_arg = {1.0f, 0};
+    std::vector<QuantArg> filter_args(out_c, {1.0f, 0});
+    QuantArg output_arg = {1.0f, quant.output_zp};
+    SetConvQuantArg(&conv_param, &quant, &input_arg, filter_args.data(), &output_arg);
+
+    // Scalar reference, origin weight layout [out_c][kernel_h][kernel_w][in_c]
+    std::vector<int8_t> benchmark(conv_param.output_batch_ * out_plane * out_c);
+    for (int b = 0; b < conv_param.output_batch_; b++) {
+      for (int oh = 0; oh < conv_param.output_h_; oh++) {
+        for (int ow = 0; ow < conv_param.output_w_; ow++) {
+          for (int oc = 0; oc < out_c; oc++) {
+            int32_t acc = bias[oc];
+            for (int kh = 0; kh < conv_param.kernel_h_; kh++) {
+              for (int kw = 0; kw < conv_param.kernel_w_; kw++) {
+                int ih = oh * conv_param.stride_h_ - conv_param.pad_u_ + kh * conv_param.dilation_h_;
+                int iw = ow * conv_param.stride_w_ - conv_param.pad_l_ + kw * conv_param.dilation_w_;
+                if (ih < 0 || ih >= conv_param.input_h_ || iw < 0 || iw >= conv_param.input_w_) {
+                  continue;
+                }
+                for (int ic = 0; ic < in_c; ic++) {
+                  acc += input[((b * conv_param.input_h_ + ih) * conv_param.input_w_ + iw) * in_c + ic] *
+                         origin_weight[oc * deep + (kh * conv_param.kernel_w_ + kw) * in_c + ic];
+                }
+              }
+            }
+            benchmark[(b * out_plane + oh * conv_param.output_w_ + ow) * out_c + oc] =
+              RequantRef(acc, quant, quant.output_zp, quant.per_channel ? oc : 0);
+          }
+        }
+      }
+    }
+
+    std::vector<bool> optimize_settings = {false};
+#ifdef ENABLE_ARM64
+    if (mindspore::lite::IsSupportSDot()) {
+      optimize_settings.push_back(true);
+    }
+#endif
+    for (bool is_optimize : optimize_settings) {
+      const int tile_num = conv_param.tile_num_;
+      const int thread_num = conv_param.thread_num_;
+      const int unit_size = is_optimize ? UP_ROUND(deep, C4NUM) : UP_ROUND(deep, C16NUM);
+      const int up_round_oc = is_optimize ? UP_ROUND(out_c, C8NUM) : UP_ROUND(out_c, C4NUM);
+      std::vector<int8_t> packed_weight(up_round_oc * unit_size, 0);
+      MATMUL_OPT_R_FUNC matmul_func = nullptr;
+      if (is_optimize) {
+#ifdef ENABLE_ARM64
+        RowMajor2Row8x4MajorInt8(origin_weight.data(), packed_weight.data(), out_c, deep);
+        matmul_func = MatMulRInt8_optimize_handler;
+#endif
+      } else {
+        RowMajor2Row16x4MajorInt8(origin_weight.data(), packed_weight.data(), out_c, deep);
+      }
+      std::vector<int8_t> packed_input(unit_size * tile_num * thread_num, 0);
+      std::vector<int8_t> matmul_input(deep * tile_num * thread_num, 0);
+      std::vector<int32_t> input_sum(tile_num * up_round_oc * thread_num, 0);
+      std::vector<int8_t> output(benchmark.size(), 0);
+      timer.Record(is_optimize ? "ConvInt8_optimize" : "ConvInt8", [&]() {
+        for (int task_id = 0; task_id < thread_num; task_id++) {
+          ConvInt8(input.data(), packed_input.data(), matmul_input.data(), packed_weight.data(), bias.data(),
+                   output.data(), filter_zp.data(), input_sum.data(), task_id, &conv_param, matmul_func, is_optimize);
+        }
+      });
+      for (size_t i = 0; i < output.size(); i++) {
+        ASSERT_EQ(output[i], benchmark[i])
+          << "seed=" << kFuzzSeed << " iter=" << iter << " is_optimize=" << is_optimize << " index=" << i
+          << " in=" << conv_param.input_batch_ << "x" << conv_param.input_h_ << "x" << conv_param.input_w_ << "x"
+          << in_c << " out_c=" << out_c << " kernel=" << conv_param.kernel_h_ << "x" << conv_param.kernel_w_
+          << " stride=" << conv_param.stride_h_ << "x" << conv_param.stride_w_ << " tile=" << tile_num
+          << " threads=" << thread_num << " per_channel=" << quant.per_channel;
+      }
+    }
+  }
+  timer.CheckBaseline();
+}
+
+// Testcase2: ConvDwInt8SW random shapes, kernels up to 7x7, dilation, per-channel input zero points
+TEST_F(ConvDwInt8Test, ConvDwInt8SW_DiffFuzz) {
+  std::mt19937 rng(kFuzzSeed + 1);
+  KernelTimer timer;
+  for (int iter = 0; iter < kFuzzIterations; iter++) {
+    ConvParameter conv_param;
+    memset(&conv_param, 0, sizeof(ConvParameter));
+    const int channel = C8NUM * RandInt(&rng, 1, 3);
+    conv_param.input_batch_ = RandInt(&rng, 1, 2);
+    conv_param.input_h_ = RandInt(&rng, 1, 16);
+    conv_param.input_w_ = RandInt(&rng, 1, 16);
+    conv_param.input_channel_ = channel;
+    conv_param.output_channel_ = channel;
+    conv_param.kernel_h_ = RandInt(&rng, 1, 7);
+    conv_param.kernel_w_ = RandInt(&rng, 1, 7);
+    conv_param.stride_h_ = RandInt(&rng, 1, 2);
+    conv_param.stride_w_ = RandInt(&rng, 1, 2);
+    conv_param.dilation_h_ = RandInt(&rng, 1, 2);
+    conv_param.dilation_w_ = RandInt(&rng, 1, 2);
+    conv_param.pad_u_ = RandInt(&rng, 0, conv_param.kernel_h_ / 2);
+    conv_param.pad_d_ = conv_param.pad_u_;
+    conv_param.pad_l_ = RandInt(&rng, 0, conv_param.kernel_w_ / 2);
+    conv_param.pad_r_ = conv_param.pad_l_;
+    int extent_h = (conv_param.kernel_h_ - 1) * conv_param.dilation_h_ + 1;
+    int extent_w = (conv_param.kernel_w_ - 1) * conv_param.dilation_w_ + 1;
+    conv_param.output_h_ = (conv_param.input_h_ + 2 * conv_param.pad_u_ - extent_h) / conv_param.stride_h_ + 1;
+    conv_param.output_w_ = (conv_param.input_w_ + 2 * conv_param.pad_l_ - extent_w) / conv_param.stride_w_ + 1;
+    if (conv_param.output_h_ <= 0 || conv_param.output_w_ <= 0) {
+      continue;
+    }
+    conv_param.output_batch_ = conv_param.input_batch_;
+    conv_param.group_ = channel;
+    conv_param.thread_num_ = RandInt(&rng, 1, 3);
+
+    std::vector<int8_t> input(conv_param.input_batch_ * conv_param.input_h_ * conv_param.input_w_ * channel);
+    for (auto &value : input) value = static_cast<int8_t>(RandInt(&rng, -128, 127));
+    // Weight: [c_block][kernel_h][kernel_w][8], int16 with the filter zero point already subtracted
+    SlidingWindowParam sliding = DepthwiseSliding(conv_param);
+    ASSERT_TRUE(SlidingInBounds(sliding, conv_param))
+      << "seed=" << kFuzzSeed + 1 << " iter=" << iter << " left=" << sliding.left_ << " right=" << sliding.right_
+      << " top=" << sliding.top_ << " bottom=" << sliding.bottom_;
+    std::vector<int16_t> weight(sliding.c_block_ * sliding.kernel_step_);
+    for (auto &value : weight) value = static_cast<int16_t>(RandInt(&rng, -255, 255));
+    std::vector<int32_t> bias(channel);
+    for (auto &value : bias) value = RandInt(&rng, -20000, 20000);
+    std::vector<int8_t> input_zp(channel);
+    for (auto &value : input_zp) value = static_cast<int8_t>(RandInt(&rng, -20, 20));
+    FuzzQuant quant = RandomQuant(&rng, channel);
+    std::vector<int32_t> output_zp(channel, quant.output_zp);
+    QuantArg input_arg = {1.0f, 0};
+    QuantArg filter_arg = {1.0f, 0};
+    QuantArg output_arg = {1.0f, quant.output_zp};
+    SetConvQuantArg(&conv_param, &quant, &input_arg, &filter_arg, &output_arg);
+    // The sliding-window kernel always indexes the quant arrays per channel
+    conv_param.conv_quant_arg_.per_channel_ = FILTER_PER_CHANNEL;
+
+    auto weight_at = [&](int c, int kh, int kw) {
+      return static_cast<int32_t>(
+        weight[(c / C8NUM) * sliding.kernel_step_ + (kh * conv_param.kernel_w_ + kw) * C8NUM + c % C8NUM]);
+    };
+    std::vector<int8_t> benchmark =
+      DepthwiseInt8Ref(input, conv_param, weight_at, bias, input_zp, output_zp, quant);
+
+    std::vector<int8_t> output(benchmark.size(), 0);
+    timer.Record("ConvDwInt8SW", [&]() {
+      for (int task_id = 0; task_id < conv_param.thread_num_; task_id++) {
+        ConvDwInt8SW(output.data(), input.data(), weight.data(), bias.data(), input_zp.data(), output_zp.data(),
+                     &conv_param, &sliding, task_id);
+      }
+    });
+    for (size_t i = 0; i < output.size(); i++) {
+      ASSERT_EQ(output[i], benchmark[i])
+        << "seed=" << kFuzzSeed + 1 << " iter=" << iter << " index=" << i << " in=" << conv_param.input_batch_ << "x"
+        << conv_param.input_h_ << "x" << conv_param.input_w_ << "x" << channel << " kernel=" << conv_param.kernel_h_
+        << "x" << conv_param.kernel_w_ << " stride=" << conv_param.stride_h_ << "x" << conv_param.stride_w_
+        << " dilation=" << conv_param.dilation_h_ << "x" << conv_param.dilation_w_ << " pad=" << conv_param.pad_u_
+        << "," << conv_param.pad_l_ << " threads=" << conv_param.thread_num_;
+    }
+  }
+  timer.CheckBaseline();
+}
+
+// Testcase3: ConvDw3x3Int8 (center) + ConvDw3x3Int8Pad (border), stride 1/2, nonzero input zero point
+// Shapes are restricted to the ones the runtime selects the 3x3 int8 path for: pad 1 and exact cover,
+// (out - 1) * stride + 3 == in + 2 * pad. ConvDw3x3Int8Pad walks a fixed one-pixel ring and is only
+// called when the sliding center is smaller than the output.
+TEST_F(ConvDw3x3Int8Test, ConvDw3x3Int8_DiffFuzz) {
+  std::mt19937 rng(kFuzzSeed + 2);
+  KernelTimer timer;
+  for (int iter = 0; iter < kFuzzIterations; iter++) {
+    ConvParameter conv_param;
+    memset(&conv_param, 0, sizeof(ConvParameter));
+    const int channel = C8NUM * RandInt(&rng, 1, 3);
+    const int stride = RandInt(&rng, 1, 2);
+    const int pad = 1;
+    conv_param.input_batch_ = RandInt(&rng, 1, 2);
+    conv_param.output_h_ = stride == 1 ? RandInt(&rng, 3, 20) : RandInt(&rng, 2, 10);
+    conv_param.output_w_ = stride == 1 ? RandInt(&rng, 3, 40) : RandInt(&rng, 2, 20);
+    conv_param.input_h_ = (conv_param.output_h_ - 1) * stride + 3 - 2 * pad;
+    conv_param.input_w_ = (conv_param.output_w_ - 1) * stride + 3 - 2 * pad;
+    conv_param.input_channel_ = channel;
+    conv_param.output_channel_ = channel;
+    conv_param.kernel_h_ = 3;
+    conv_param.kernel_w_ = 3;
+    conv_param.stride_h_ = stride;
+    conv_param.stride_w_ = stride;
+    conv_param.dilation_h_ = 1;
+    conv_param.dilation_w_ = 1;
+    conv_param.pad_u_ = pad;
+    conv_param.pad_d_ = pad;
+    conv_param.pad_l_ = pad;
+    conv_param.pad_r_ = pad;
+    conv_param.output_batch_ = conv_param.input_batch_;
+    conv_param.group_ = channel;
+    conv_param.thread_num_ = RandInt(&rng, 1, 3);
+
+    std::vector<int8_t> input(conv_param.input_batch_ * conv_param.input_h_ * conv_param.input_w_ * channel);
+    for (auto &value : input) value = static_cast<int8_t>(RandInt(&rng, -128, 127));
+    // Weight: [3][3][channel], int16 with the filter zero point already subtracted
+    std::vector<int16_t> weight(9 * channel);
+    for (auto &value : weight) value = static_cast<int16_t>(RandInt(&rng, -255, 255));
+    std::vector<int32_t> bias(channel);
+    for (auto &value : bias) value = RandInt(&rng, -20000, 20000);
+    const int layer_input_zp = RandInt(&rng, -20, 20);
+    std::vector<int8_t> input_zp(channel, static_cast<int8_t>(layer_input_zp));
+    FuzzQuant quant = RandomQuant(&rng, channel);
+    std::vector<int32_t> output_zp(channel, quant.output_zp);
+    QuantArg input_arg = {1.0f, layer_input_zp};
+    QuantArg filter_arg = {1.0f, 0};
+    QuantArg output_arg = {1.0f, quant.output_zp};
+    SetConvQuantArg(&conv_param, &quant, &input_arg, &filter_arg, &output_arg);
+    SlidingWindowParam sliding = DepthwiseSliding(conv_param);
+    ASSERT_TRUE(SlidingInBounds(sliding, conv_param))
+      << "seed=" << kFuzzSeed + 2 << " iter=" << iter << " left=" << sliding.left_ << " right=" << sliding.right_
+      << " top=" << sliding.top_ << " bottom=" << sliding.bottom_;
+
+    auto weight_at = [&](int c, int kh, int kw) { return static_cast<int32_t>(weight[(kh * 3 + kw) * channel + c]); };
+    std::vector<int8_t> benchmark =
+      DepthwiseInt8Ref(input, conv_param, weight_at, bias, input_zp, output_zp, quant);
+
+    // One scratch block per task, as the 3x3 kernel wrapper hands out buffer_ + task_id * size
+    const int buffer_per_task = 3 * (stride * (30 - 1) + 3) * 64;
+    std::vector<int8_t> buffer(buffer_per_task * conv_param.thread_num_, 0);
+    std::vector<int8_t> output(benchmark.size(), 0);
+    timer.Record("ConvDw3x3Int8", [&]() {
+      for (int task_id = 0; task_id < conv_param.thread_num_; task_id++) {
+        ConvDw3x3Int8(output.data(), buffer.data() + task_id * buffer_per_task, input.data(), weight.data(),
+                      bias.data(), &conv_param, &sliding, task_id);
+      }
+    });
+    const bool has_border =
+      sliding.right_ - sliding.left_ < conv_param.output_w_ || sliding.bottom_ - sliding.top_ < conv_param.output_h_;
+    if (has_border) {
+      timer.Record("ConvDw3x3Int8Pad", [&]() {
+        ConvDw3x3Int8Pad(output.data(), input.data(), weight.data(), bias.data(), &conv_param, &sliding);
+      });
+    }
+    for (size_t i = 0; i < output.size(); i++) {
+      ASSERT_EQ(output[i], benchmark[i])
+        << "seed=" << kFuzzSeed + 2 << " iter=" << iter << " index=" << i << " in=" << conv_param.input_batch_ << "x"
+        << conv_param.input_h_ << "x" << conv_param.input_w_ << "x" << channel << " stride=" << stride
+        << " input_zp=" << layer_input_zp << " threads=" << conv_param.thread_num_
+        << " per_channel=" << quant.per_channel;
+    }
+  }
+  timer.CheckBaseline();
+}
+
+// Testcase4: ConvDwInt8SW regression shapes whose padded kernel never fits in the output, e.g.
+// in_w=3, kernel_w=3, dilation 2, pad 1, stride 1 -> out_w=1, where an unguarded split gives
+// left=1, right=-1 and the right-border pass writes ow=-1. The center must come out empty.
+TEST_F(ConvDwInt8Test, ConvDwInt8SW_NarrowOutputSliding) {
+  struct NarrowShape {
+    int in_h, in_w, kernel, dilation, pad, stride;
+  };
+  const std::vector<NarrowShape> shapes = {
+    {3, 3, 3, 2, 1, 1}, {1, 1, 3, 1, 1, 1}, {5, 5, 5, 2, 2, 2}, {4, 2, 7, 1, 3, 1}, {3, 3, 2, 2, 1, 2}};
+  std::mt19937 rng(kFuzzSeed + 3);
+  for (size_t n = 0; n < shapes.size(); n++) {
+    const NarrowShape &shape = shapes[n];
+    ConvParameter conv_param;
+    memset(&conv_param, 0, sizeof(ConvParameter));
+    const int channel = C8NUM;
+    conv_param.input_batch_ = 1;
+    conv_param.input_h_ = shape.in_h;
+    conv_param.input_w_ = shape.in_w;
+    conv_param.input_channel_ = channel;
+    conv_param.output_channel_ = channel;
+    conv_param.kernel_h_ = shape.kernel;
+    conv_param.kernel_w_ = shape.kernel;
+    conv_param.stride_h_ = shape.stride;
+    conv_param.stride_w_ = shape.stride;
+    conv_param.dilation_h_ = shape.dilation;
+    conv_param.dilation_w_ = shape.dilation;
+    conv_param.pad_u_ = shape.pad;
+    conv_param.pad_d_ = shape.pad;
+    conv_param.pad_l_ = shape.pad;
+    conv_param.pad_r_ = shape.pad;
+    const int extent = (shape.kernel - 1) * shape.dilation + 1;
+    conv_param.output_h_ = (shape.in_h + 2 * shape.pad - extent) / shape.stride + 1;
+    conv_param.output_w_ = (shape.in_w + 2 * shape.pad - extent) / shape.stride + 1;
+    ASSERT_GT(conv_param.output_h_, 0) << "shape " << n;
+    ASSERT_GT(conv_param.output_w_, 0) << "shape " << n;
+    conv_param.output_batch_ = 1;
+    conv_param.group_ = channel;
+    conv_param.thread_num_ = 1;
+
+    SlidingWindowParam sliding = DepthwiseSliding(conv_param);
+    ASSERT_TRUE(SlidingInBounds(sliding, conv_param))
+      << "shape " << n << " left=" << sliding.left_ << " right=" << sliding.right_ << " top=" << sliding.top_
+      << " bottom=" << sliding.bottom_;
+
+    std::vector<int8_t> input(shape.in_h * shape.in_w * channel);
+    for (auto &value : input) value = static_cast<int8_t>(RandInt(&rng, -128, 127));
+    std::vector<int16_t> weight(sliding.c_block_ * sliding.kernel_step_);
+    for (auto &value : weight) value = static_cast<int16_t>(RandInt(&rng, -255, 255));
+    std::vector<int32_t> bias(channel);
+    for (auto &value : bias) value = RandInt(&rng, -20000, 20000);
+    std::vector<int8_t> input_zp(channel);
+    for (auto &value : input_zp) value = static_cast<int8_t>(RandInt(&rng, -20, 20));
+    FuzzQuant quant = RandomQuant(&rng, channel);
+    std::vector<int32_t> output_zp(channel, quant.output_zp);
+    QuantArg input_arg = {1.0f, 0};
+    QuantArg filter_arg = {1.0f, 0};
+    QuantArg output_arg = {1.0f, quant.output_zp};
+    SetConvQuantArg(&conv_param, &quant, &input_arg, &filter_arg, &output_arg);
+    conv_param.conv_quant_arg_.per_channel_ = FILTER_PER_CHANNEL;
+
+    auto weight_at = [&](int c, int kh, int kw) {
+      return static_cast<int32_t>(
+        weight[(c / C8NUM) * sliding.kernel_step_ + (kh * conv_param.kernel_w_ + kw) * C8NUM + c % C8NUM]);
+    };
+    std::vector<int8_t> benchmark =
+      DepthwiseInt8Ref(input, conv_param, weight_at, bias, input_zp, output_zp, quant);
+
+    // Guard bytes on both sides catch a border pass that writes outside [0, output_w_)
+    const int guard = channel * conv_param.output_w_ + channel;
+    std::vector<int8_t> output(guard + benchmark.size() + guard, 0x5a);
+    ConvDwInt8SW(output.data() + guard, input.data(), weight.data(), bias.data(), input_zp.data(), output_zp.data(),
+                 &conv_param, &sliding, 0);
+    for (int i = 0; i < guard; i++) {
+      ASSERT_EQ(output[i], 0x5a) << "shape " << n << " wrote before the output at " << i - guard;
+      ASSERT_EQ(output[guard + benchmark.size() + i], 0x5a) << "shape " << n << " wrote past the output at " << i;
+    }
+    for (size_t i = 0; i < benchmark.size(); i++) {
+      ASSERT_EQ(output[guard + i], benchmark[i]) << "shape " << n << " index=" << i;
+    }
+  }
+}
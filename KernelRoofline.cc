@@ -0,0 +1,347 @@
+// Microbenchmark and roofline report for the depthwise int8 kernels and Lstm.
+// The host roofline is measured once: streaming triad bandwidth, an int16 x int16 -> int32 MAC peak
+// for the depthwise kernels (their int8 input is widened against int16 weights) and an fp32
+// multiply-add peak for Lstm. Each kernel is then swept over shapes large enough to leave L1/L2 and
+// reported as achieved GB/s, GOP/s, arithmetic intensity and the fraction of its own roofline bound.
+// Ops count a multiply and an add as two operations. The sweeps are disabled by default; run them
+// with --gtest_also_run_disabled_tests.
+namespace {
+constexpr double kMinBenchUs = 20000.0;
+
+struct Roofline {
+  double bandwidth_gbs;
+  double peak_int16_gops;
+  double peak_fp32_gflops;
+};
+
+const Roofline &HostRoofline() {
+  static Roofline roofline = []() {
+    Roofline result;
+    // Triad over 3 x 64MB so caches do not help
+    const size_t count = 16 * 1024 * 1024;
+    std::vector<float> a(count, 0.0f);
+    std::vector<float> b(count, 1.0f);
+    std::vector<float> c(count, 2.0f);
+    double best_us = std::numeric_limits<double>::max();
+    for (int r = 0; r < 3; r++) {
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < count; i++) {
+        a[i] = b[i] + 0.5f * c[i];
+      }
+      auto end = std::chrono::steady_clock::now();
+      best_us = std::min(best_us, std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    result.bandwidth_gbs = 3.0 * count * sizeof(float) / best_us / 1e3;
+    EXPECT_GT(a[count / 2], 0.0f);
+
+    // 64 independent int16 x int16 -> int32 MAC chains over cache-resident operands, the shape of the
+    // depthwise inner loop; the operand row changes every iteration so the sum cannot be folded
+    const int chains = 64;
+    const int iterations = 1 << 20;
+    int16_t operand[4][chains];
+    int16_t weight[chains];
+    int32_t int_acc[chains];
+    for (int k = 0; k < chains; k++) {
+      for (int row = 0; row < 4; row++) {
+        operand[row][k] = static_cast<int16_t>((row * 31 + k * 7) % 255 - 127);
+      }
+      weight[k] = static_cast<int16_t>(k % 31 - 15);
+      int_acc[k] = 0;
+    }
+    auto int_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+      const int16_t *row = operand[i & 3];
+      for (int k = 0; k < chains; k++) {
+        int_acc[k] += static_cast<int32_t>(row[k]) * weight[k];
+      }
+    }
+    auto int_end = std::chrono::steady_clock::now();
+    double int_us = std::chrono::duration<double, std::micro>(int_end - int_start).count();
+    result.peak_int16_gops = 2.0 * chains * iterations / int_us / 1e3;
+    int64_t int_sum = 0;
+    for (int k = 0; k < chains; k++) {
+      int_sum += int_acc[k];
+    }
+    volatile int64_t int_sink = int_sum;
+    (void)int_sink;
+
+    // 64 independent fp32 multiply-add chains, wide enough for the compiler to vectorize
+    float acc[chains];
+    for (int k = 0; k < chains; k++) {
+      acc[k] = static_cast<float>(k);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+      for (int k = 0; k < chains; k++) {
+        acc[k] = acc[k] * 0.999999f + 1e-7f;
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count();
+    result.peak_fp32_gflops = 2.0 * chains * iterations / us / 1e3;
+    float sum = 0;
+    for (int k = 0; k < chains; k++) {
+      sum += acc[k];
+    }
+    EXPECT_TRUE(std::isfinite(sum));
+
+    std::cout << "[roofline] host bandwidth " << result.bandwidth_gbs << " GB/s, int16 MAC peak "
+              << result.peak_int16_gops << " GOP/s (ridge " << result.peak_int16_gops / result.bandwidth_gbs
+              << " op/byte), fp32 peak " << result.peak_fp32_gflops << " GFLOP/s (ridge "
+              << result.peak_fp32_gflops / result.bandwidth_gbs << " op/byte)" << std::endl;
+    return result;
+  }();
+  return roofline;
+}
+
+// Best time of repeated runs, repeating until at least kMinBenchUs has been spent
+double BenchUs(const std::function<void()> &func) {
+  func();
+  double best_us = std::numeric_limits<double>::max();
+  double total_us = 0;
+  int runs = 0;
+  while (runs < 3 || total_us < kMinBenchUs) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count();
+    best_us = std::min(best_us, us);
+    total_us += us;
+    runs++;
+  }
+  return best_us;
+}
+
+// peak_gops is the compute ceiling matching the kernel's arithmetic (int16 MAC or fp32)
+void ReportRoofline(const std::string &kernel, const std::string &shape, double bytes, double ops, double us,
+                    double peak_gops) {
+  const Roofline &roofline = HostRoofline();
+  double gbs = bytes / us / 1e3;
+  double gops = ops / us / 1e3;
+  double intensity = ops / bytes;
+  double bound_gops = std::min(peak_gops, intensity * roofline.bandwidth_gbs);
+  bool memory_bound = intensity * roofline.bandwidth_gbs < peak_gops;
+  std::cout << "[roofline] " << kernel << " " << shape << ": " << us << " us, " << gbs << " GB/s, " << gops
+            << " GOP/s, " << intensity << " op/byte, " << (memory_bound ? "memory" : "compute") << "-bound, "
+            << 100.0 * gops / bound_gops << "% of roofline" << std::endl;
+}
+
+struct DepthwiseBenchCase {
+  ConvParameter conv_param;
+  SlidingWindowParam sliding;
+  std::vector<int8_t> input;
+  std::vector<int16_t> weight;
+  std::vector<int32_t> bias;
+  std::vector<int8_t> input_zp;
+  std::vector<int32_t> output_zp;
+  std::vector<int32_t> quant_multiplier;
+  std::vector<int32_t> left_shift;
+  std::vector<int32_t> right_shift;
+  std::vector<int32_t> out_act_min;
+  std::vector<int32_t> out_act_max;
+  std::vector<int8_t> output;
+  QuantArg input_quant_arg;
+  QuantArg filter_quant_arg;
+  QuantArg output_quant_arg;
+};
+
+enum DepthwiseWeightLayout {
+  kSlidingWindowLayout,  // ConvDwInt8SW: [c_block][3][3][8]
+  kDw3x3Layout,          // ConvDw3x3Int8/ConvDw3x3Int8Pad: [3][3][channel]
+};
+
+// 3x3, stride 1, pad 1 depthwise layer of size x size x channel with the sliding center [1, size - 1);
+// the same logical weights are packed in the layout the benchmarked kernel reads
+void InitDepthwiseBenchCase(DepthwiseBenchCase *bench, int size, int channel, DepthwiseWeightLayout layout) {
+  memset(&bench->conv_param, 0, sizeof(ConvParameter));
+  ConvParameter &conv_param = bench->conv_param;
+  conv_param.kernel_h_ = 3;
+  conv_param.kernel_w_ = 3;
+  conv_param.stride_h_ = 1;
+  conv_param.stride_w_ = 1;
+  conv_param.dilation_h_ = 1;
+  conv_param.dilation_w_ = 1;
+  conv_param.pad_u_ = 1;
+  conv_param.pad_d_ = 1;
+  conv_param.pad_l_ = 1;
+  conv_param.pad_r_ = 1;
+  conv_param.input_batch_ = 1;
+  conv_param.input_h_ = size;
+  conv_param.input_w_ = size;
+  conv_param.input_channel_ = channel;
+  conv_param.output_batch_ = 1;
+  conv_param.output_h_ = size;
+  conv_param.output_w_ = size;
+  conv_param.output_channel_ = channel;
+  conv_param.group_ = channel;
+  conv_param.thread_num_ = 1;
+
+  bench->input.resize(size * size * channel);
+  for (size_t i = 0; i < bench->input.size(); i++) {
+    bench->input[i] = static_cast<int8_t>(static_cast<int>(i * 37 % 255) - 127);
+  }
+  bench->weight.resize(9 * channel);
+  for (int c = 0; c < channel; c++) {
+    for (int k = 0; k < 9; k++) {
+      int16_t value = static_cast<int16_t>((c * 9 + k) * 13 % 31 - 15);
+      if (layout == kSlidingWindowLayout) {
+        bench->weight[(c / C8NUM) * 9 * C8NUM + k * C8NUM + c % C8NUM] = value;
+      } else {
+        bench->weight[k * channel + c] = value;
+      }
+    }
+  }
+  bench->bias.assign(channel, 0);
+  bench->input_zp.assign(channel, 0);
+  bench->output_zp.assign(channel, 0);
+  bench->quant_multiplier.assign(channel, 1073741824);
+  bench->left_shift.assign(channel, 0);
+  bench->right_shift.assign(channel, -8);
+  bench->out_act_min.assign(channel, -128);
+  bench->out_act_max.assign(channel, 127);
+  bench->output.assign(size * size * channel, 0);
+  bench->input_quant_arg = {1.0f, 0};
+  bench->filter_quant_arg = {1.0f, 0};
+  bench->output_quant_arg = {1.0f, 0};
+  conv_param.conv_quant_arg_.input_quant_args_ = &bench->input_quant_arg;
+  conv_param.conv_quant_arg_.filter_quant_args_ = &bench->filter_quant_arg;
+  conv_param.conv_quant_arg_.output_quant_args_ = &bench->output_quant_arg;
+  conv_param.conv_quant_arg_.quant_multiplier_ = bench->quant_multiplier.data();
+  conv_param.conv_quant_arg_.left_shift_ = bench->left_shift.data();
+  conv_param.conv_quant_arg_.right_shift_ = bench->right_shift.data();
+  conv_param.conv_quant_arg_.out_act_min_ = bench->out_act_min.data();
+  conv_param.conv_quant_arg_.out_act_max_ = bench->out_act_max.data();
+  conv_param.conv_quant_arg_.per_channel_ = FILTER_PER_CHANNEL;
+
+  memset(&bench->sliding, 0, sizeof(SlidingWindowParam));
+  SlidingWindowParam &sliding = bench->sliding;
+  sliding.left_ = 1;
+  sliding.right_ = size - 1;
+  sliding.top_ = 1;
+  sliding.bottom_ = size - 1;
+  sliding.c_block_ = channel / C8NUM;
+  sliding.block_channel_ = channel;
+  sliding.ic_align_ = channel;
+  sliding.out_step_ = size * size * channel;
+  sliding.out_h_step_ = size * channel;
+  sliding.out_c_step_ = 1;
+  sliding.out_w_step_ = channel;
+  sliding.in_step_ = size * size * channel;
+  sliding.in_h_step_ = size * channel;
+  sliding.in_sh_step_ = size * channel;
+  sliding.in_sw_step_ = channel;
+  sliding.in_kh_step_ = size * channel;
+  sliding.in_kw_step_ = channel;
+  sliding.kernel_step_ = layout == kSlidingWindowLayout ? 9 * C8NUM : 9 * channel;
+}
+
+double DepthwiseBytes(int size, int channel) {
+  // int8 input + int8 output + int16 weights + int32 bias, each touched once
+  return 2.0 * size * size * channel + 9.0 * channel * sizeof(int16_t) + channel * sizeof(int32_t);
+}
+
+double DepthwiseOps(int size, int channel) { return 2.0 * 9 * size * size * channel; }
+
+const std::vector<int> kDepthwiseSizes = {14, 28, 56, 112};
+const std::vector<int> kDepthwiseChannels = {32, 64, 128, 256};
+}  // namespace
+
+// Testcase1: ConvDwInt8SW 3x3 stride 1 pad 1 over feature-map size x channel
+TEST_F(ConvDwInt8Test, DISABLED_ConvDwInt8SW_Roofline) {
+  for (int size : kDepthwiseSizes) {
+    for (int channel : kDepthwiseChannels) {
+      DepthwiseBenchCase bench;
+      InitDepthwiseBenchCase(&bench, size, channel, kSlidingWindowLayout);
+      double us = BenchUs([&]() {
+        ConvDwInt8SW(bench.output.data(), bench.input.data(), bench.weight.data(), bench.bias.data(),
+                     bench.input_zp.data(), bench.output_zp.data(), &bench.conv_param, &bench.sliding, 0);
+      });
+      std::ostringstream shape;
+      shape << size << "x" << size << "x" << channel;
+      ReportRoofline("ConvDwInt8SW", shape.str(), DepthwiseBytes(size, channel), DepthwiseOps(size, channel), us,
+                     HostRoofline().peak_int16_gops);
+    }
+  }
+}
+
+// Testcase2: ConvDw3x3Int8 (center) + ConvDw3x3Int8Pad (border) over feature-map size x channel
+TEST_F(ConvDw3x3Int8Test, DISABLED_ConvDw3x3Int8_Roofline) {
+  std::vector<int8_t> buffer(3 * (30 - 1 + 3) * 64, 0);
+  for (int size : kDepthwiseSizes) {
+    for (int channel : kDepthwiseChannels) {
+      DepthwiseBenchCase bench;
+      InitDepthwiseBenchCase(&bench, size, channel, kDw3x3Layout);
+      double us = BenchUs([&]() {
+        ConvDw3x3Int8(bench.output.data(), buffer.data(), bench.input.data(), bench.weight.data(),
+                      bench.bias.data(), &bench.conv_param, &bench.sliding, 0);
+        ConvDw3x3Int8Pad(bench.output.data(), bench.input.data(), bench.weight.data(), bench.bias.data(),
+                         &bench.conv_param, &bench.sliding);
+      });
+      std::ostringstream shape;
+      shape << size << "x" << size << "x" << channel;
+      ReportRoofline("ConvDw3x3Int8+Pad", shape.str(), DepthwiseBytes(size, channel), DepthwiseOps(size, channel),
+                     us, HostRoofline().peak_int16_gops);
+    }
+  }
+}
+
+// Testcase3: unidirectional Lstm over hidden_size x seq_len x batch (input_size == hidden_size)
+TEST_F(LstmFp32Test, DISABLED_Lstm_Roofline) {
+  const std::vector<int> hidden_sizes = {128, 256, 512};
+  const std::vector<int> seq_lens = {8, 32};
+  const std::vector<int> batches = {2, 8};
+  for (int hidden_size : hidden_sizes) {
+    for (int seq_len : seq_lens) {
+      for (int batch_size : batches) {
+        const int input_size = hidden_size;
+        const int col_align = UP_ROUND(hidden_size, C8NUM);
+        const int row_align = UP_ROUND(seq_len * batch_size, C12NUM);
+        const int state_row_align = UP_ROUND(batch_size, C12NUM);
+        std::vector<float> weight_i(4 * input_size * col_align);
+        std::vector<float> weight_h(4 * hidden_size * col_align);
+        for (size_t i = 0; i < weight_i.size(); i++) {
+          weight_i[i] = static_cast<float>(static_cast<int>(i * 7 % 17) - 8) * 0.01f;
+        }
+        for (size_t i = 0; i < weight_h.size(); i++) {
+          weight_h[i] = static_cast<float>(static_cast<int>(i * 5 % 13) - 6) * 0.01f;
+        }
+        std::vector<float> bias(8 * col_align, 0);
+        std::vector<float> input_x(seq_len * batch_size * input_size);
+        for (size_t i = 0; i < input_x.size(); i++) {
+          input_x[i] = static_cast<float>(static_cast<int>(i * 3 % 11) - 5) * 0.1f;
+        }
+        std::vector<float> hidden(batch_size * hidden_size, 0);
+        std::vector<float> cell(batch_size * hidden_size, 0);
+        std::vector<float> output_y(seq_len * batch_size * hidden_size, 0);
+        const int scratch_size = 4 * MSMAX(row_align, state_row_align) * MSMAX(input_size, col_align);
+        std::vector<std::vector<float>> buffer_storage;
+        for (int i = 0; i < 4; i++) {
+          buffer_storage.emplace_back(scratch_size, 0.0f);
+        }
+        float *buffer[7] = {buffer_storage[0].data(),
+                            buffer_storage[1].data(),
+                            buffer_storage[2].data(),
+                            buffer_storage[3].data(),
+                            nullptr,
+                            nullptr,
+                            nullptr};
+        const LstmParameter lstm_parameter = {{"", 87, 1, 0}, input_size, hidden_size, 0, hidden_size, seq_len,
+                                              batch_size, batch_size * hidden_size, false, 0, 0, row_align,
+                                              col_align, state_row_align, col_align, col_align, false};
+        double us = BenchUs([&]() {
+          std::fill(hidden.begin(), hidden.end(), 0.0f);
+          std::fill(cell.begin(), cell.end(), 0.0f);
+          Lstm(output_y.data(), input_x.data(), weight_i.data(), weight_h.data(), bias.data(), bias.data(),
+               hidden.data(), cell.data(), buffer, &lstm_parameter);
+        });
+        // weight_i is read once for the hoisted input GEMM, weight_h once per step
+        double bytes = sizeof(float) * (static_cast<double>(weight_i.size()) + seq_len * weight_h.size() +
+                                        input_x.size() + output_y.size() + 2.0 * hidden.size());
+        double ops = 2.0 * seq_len * batch_size * 4 * hidden_size * (input_size + hidden_size);
+        std::ostringstream shape;
+        shape << "hidden=" << hidden_size << " seq_len=" << seq_len << " batch=" << batch_size;
+        ReportRoofline("Lstm", shape.str(), bytes, ops, us, HostRoofline().peak_fp32_gflops);
+      }
+    }
+  }
+}
@@ -0,0 +1,220 @@
+TEST_F(GruFp32Test, Testcase01) {
+  // Bidirectional GRU using the Lstm packing: weight rows padded to 8 ([direction][gate][deep][col_align],
+  // gate order update, reset, hidden), buffer[] scratch owned by the caller, states [direction][batch][hidden].
+  const int num_direction = 2;
+  const int hidden_size = 4;
+  const int input_size = 2;
+  const int seq_len = 3;
+  const int batch_size = 2;
+  const int col_align = UP_ROUND(hidden_size, C8NUM);
+  std::vector<float> weight_g(num_direction * 3 * input_size * col_align, 0);
+  std::vector<float> weight_r(num_direction * 3 * hidden_size * col_align, 0);
+  for (int row = 0; row < num_direction * 3 * input_size; row++) {
+    for (int col = 0; col < hidden_size; col++) {
+      weight_g[row * col_align + col] = static_cast<float>((row * 7 + col * 3) % 11 - 5) * 0.15f;
+    }
+  }
+  for (int row = 0; row < num_direction * 3 * hidden_size; row++) {
+    for (int col = 0; col < hidden_size; col++) {
+      weight_r[row * col_align + col] = static_cast<float>((row * 5 + col * 9) % 13 - 6) * 0.1f;
+    }
+  }
+  std::vector<float> input_bias(num_direction * 3 * col_align, 0);
+  std::vector<float> state_bias(num_direction * 3 * col_align, 0);
+  for (int d = 0; d < num_direction; d++) {
+    for (int g = 0; g < 3; g++) {
+      for (int col = 0; col < hidden_size; col++) {
+        input_bias[(d * 3 + g) * col_align + col] = static_cast<float>((g + col + d) % 3 - 1) * 0.1f;
+        state_bias[(d * 3 + g) * col_align + col] = static_cast<float>((g * 2 + col) % 5 - 2) * 0.05f;
+      }
+    }
+  }
+  std::vector<float> input_x(seq_len * batch_size * input_size);
+  for (size_t i = 0; i < input_x.size(); i++) {
+    input_x[i] = static_cast<float>(static_cast<int>(i * 5 % 9) - 4) * 0.4f;
+  }
+  std::vector<float> input_h(num_direction * batch_size * hidden_size);
+  for (size_t i = 0; i < input_h.size(); i++) {
+    input_h[i] = static_cast<float>(static_cast<int>(i * 3 % 7) - 3) * 0.2f;
+  }
+
+  // Scalar reference following GruStepUnit: z/r gates from x and h, then the reset gate is multiplied
+  // into the state before the state-hidden GEMM, n = tanh(W_in x + b_in + W_hn (r * h) + b_hn), and
+  // h_t = (1 - z) * n + z * h_(t-1); the backward direction walks the sequence in reverse
+  const int output_y_shape = seq_len * num_direction * batch_size * hidden_size;
+  const int output_h_shape = num_direction * batch_size * hidden_size;
+  std::vector<float> benchmark_y(output_y_shape, 0.0);
+  std::vector<float> benchmark_h = input_h;
+  auto sigmoid = [](float value) { return 1.0f / (1.0f + std::exp(-value)); };
+  for (int d = 0; d < num_direction; d++) {
+    for (int step = 0; step < seq_len; step++) {
+      const int t = d == 0 ? step : seq_len - 1 - step;
+      std::vector<float> next_h(batch_size * hidden_size);
+      for (int b = 0; b < batch_size; b++) {
+        const float *prev_h = benchmark_h.data() + (d * batch_size + b) * hidden_size;
+        float gate_x[3][hidden_size];
+        for (int g = 0; g < 3; g++) {
+          for (int j = 0; j < hidden_size; j++) {
+            float acc_x = input_bias[(d * 3 + g) * col_align + j];
+            for (int k = 0; k < input_size; k++) {
+              acc_x += input_x[(t * batch_size + b) * input_size + k] *
+                       weight_g[((d * 3 + g) * input_size + k) * col_align + j];
+            }
+            gate_x[g][j] = acc_x;
+          }
+        }
+        float update[hidden_size];
+        float reset[hidden_size];
+        for (int j = 0; j < hidden_size; j++) {
+          float acc_update = state_bias[(d * 3 + 0) * col_align + j];
+          float acc_reset = state_bias[(d * 3 + 1) * col_align + j];
+          for (int k = 0; k < hidden_size; k++) {
+            acc_update += prev_h[k] * weight_r[((d * 3 + 0) * hidden_size + k) * col_align + j];
+            acc_reset += prev_h[k] * weight_r[((d * 3 + 1) * hidden_size + k) * col_align + j];
+          }
+          update[j] = sigmoid(gate_x[0][j] + acc_update);
+          reset[j] = sigmoid(gate_x[1][j] + acc_reset);
+        }
+        for (int j = 0; j < hidden_size; j++) {
+          float acc_h = 0;
+          for (int k = 0; k < hidden_size; k++) {
+            acc_h += reset[k] * prev_h[k] * weight_r[((d * 3 + 2) * hidden_size + k) * col_align + j];
+          }
+          acc_h += state_bias[(d * 3 + 2) * col_align + j];
+          float hidden = std::tanh(gate_x[2][j] + acc_h);
+          next_h[b * hidden_size + j] = (1 - update[j]) * hidden + update[j] * prev_h[j];
+        }
+      }
+      std::copy(next_h.begin(), next_h.end(), benchmark_h.begin() + d * batch_size * hidden_size);
+      std::copy(next_h.begin(), next_h.end(),
+                benchmark_y.begin() + (t * num_direction + d) * batch_size * hidden_size);
+    }
+  }
+
+  std::vector<float> output_y(output_y_shape, 0.0);
+  std::vector<std::vector<float>> buffer_storage;
+  buffer_storage.reserve(4);
+  for (int i = 0; i < 4; i++) {
+    buffer_storage.emplace_back(512, 0.0f);
+  }
+  float *buffer[4] = {buffer_storage[0].data(), buffer_storage[1].data(), buffer_storage[2].data(),
+                      buffer_storage[3].data()};
+  const GruParameter gru_parameter = {{"", 0, 1, 0},
+                                      input_size,
+                                      hidden_size,
+                                      seq_len,
+                                      batch_size,
+                                      num_direction * batch_size * hidden_size,
+                                      true,
+                                      UP_ROUND(seq_len * batch_size, C12NUM),
+                                      col_align,
+                                      UP_ROUND(batch_size, C12NUM),
+                                      col_align};
+  Gru(output_y.data(), input_x.data(), weight_g.data(), weight_r.data(), input_bias.data(), state_bias.data(),
+      input_h.data(), buffer, seq_len, &gru_parameter);
+  std::cout << "output_y :\n";
+  std::for_each(output_y.begin(), output_y.end(), [](float value) { std::cout << value << " "; });
+  std::cout << "output_h :\n";
+  std::for_each(input_h.begin(), input_h.end(), [](float value) { std::cout << value << " "; });
+  std::cout << std::endl;
+  for (int i = 0; i < output_y_shape; i++) {
+    ASSERT_NEAR(output_y[i], benchmark_y[i], 1e-5) << "y index " << i;
+  }
+  for (int i = 0; i < output_h_shape; i++) {
+    ASSERT_NEAR(input_h[i], benchmark_h[i], 1e-5) << "h index " << i;
+  }
+}
+
+TEST_F(GruFp32Test, DISABLED_Benchmark_GruVsLstm) {
+  // Same hidden/input size, sequence and batch for both cells; the GRU does 3/4 of the LSTM's
+  // GEMM work per step, so its time is reported next to the Lstm time for the same shape.
+  // Disabled by default; run with --gtest_also_run_disabled_tests.
+  const int hidden_size = 128;
+  const int input_size = 128;
+  const int seq_len = 16;
+  const int batch_size = 4;
+  const int repeat = 5;
+  const int col_align = UP_ROUND(hidden_size, C8NUM);
+  const int row_align = UP_ROUND(seq_len * batch_size, C12NUM);
+  const int state_row_align = UP_ROUND(batch_size, C12NUM);
+
+  std::vector<float> input_x(seq_len * batch_size * input_size);
+  for (size_t i = 0; i < input_x.size(); i++) {
+    input_x[i] = static_cast<float>(static_cast<int>(i * 7 % 13) - 6) * 0.05f;
+  }
+  auto make_weight = [&](int gate_num, int deep) {
+    std::vector<float> weight(gate_num * deep * col_align, 0);
+    for (int row = 0; row < gate_num * deep; row++) {
+      for (int col = 0; col < hidden_size; col++) {
+        weight[row * col_align + col] = static_cast<float>((row * 3 + col * 5) % 17 - 8) * 0.01f;
+      }
+    }
+    return weight;
+  };
+  auto elapsed_us = [&](const std::function<void()> &func) {
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r < repeat; r++) {
+      auto start = std::chrono::steady_clock::now();
+      func();
+      auto end = std::chrono::steady_clock::now();
+      best = std::min(best, std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    return best;
+  };
+  const int scratch_size = MSMAX(row_align, state_row_align) * MSMAX(input_size, hidden_size) * 4 +
+                           4 * seq_len * batch_size * col_align;
+  std::vector<std::vector<float>> buffer_storage;
+  for (int i = 0; i < 4; i++) {
+    buffer_storage.emplace_back(scratch_size, 0.0f);
+  }
+
+  // GRU
+  std::vector<float> weight_g = make_weight(3, input_size);
+  std::vector<float> weight_r = make_weight(3, hidden_size);
+  std::vector<float> gru_bias(3 * col_align, 0);
+  std::vector<float> gru_h(batch_size * hidden_size, 0);
+  std::vector<float> gru_y(seq_len * batch_size * hidden_size, 0);
+  float *gru_buffer[4] = {buffer_storage[0].data(), buffer_storage[1].data(), buffer_storage[2].data(),
+                          buffer_storage[3].data()};
+  const GruParameter gru_parameter = {{"", 0, 1, 0}, input_size, hidden_size, seq_len, batch_size,
+                                      batch_size * hidden_size, false, row_align, col_align, state_row_align,
+                                      col_align};
+  double gru_us = elapsed_us([&]() {
+    std::fill(gru_h.begin(), gru_h.end(), 0.0f);
+    Gru(gru_y.data(), input_x.data(), weight_g.data(), weight_r.data(), gru_bias.data(), gru_bias.data(),
+        gru_h.data(), gru_buffer, seq_len, &gru_parameter);
+  });
+
+  // LSTM
+  std::vector<float> weight_i = make_weight(4, input_size);
+  std::vector<float> weight_h = make_weight(4, hidden_size);
+  std::vector<float> lstm_bias(8 * col_align, 0);
+  std::vector<float> lstm_h(batch_size * hidden_size, 0);
+  std::vector<float> lstm_c(batch_size * hidden_size, 0);
+  std::vector<float> lstm_y(seq_len * batch_size * hidden_size, 0);
+  float *lstm_buffer[7] = {buffer_storage[0].data(),
+                           buffer_storage[1].data(),
+                           buffer_storage[2].data(),
+                           buffer_storage[3].data(),
+                           nullptr,
+                           nullptr,
+                           nullptr};
+  const LstmParameter lstm_parameter = {{"", 87, 1, 0}, input_size, hidden_size, 0, hidden_size, seq_len,
+                                        batch_size, batch_size * hidden_size, false, 0, 0, row_align, col_align,
+                                        state_row_align, col_align, col_align, false};
+  double lstm_us = elapsed_us([&]() {
+    std::fill(lstm_h.begin(), lstm_h.end(), 0.0f);
+    std::fill(lstm_c.begin(), lstm_c.end(), 0.0f);
+    Lstm(lstm_y.data(), input_x.data(), weight_i.data(), weight_h.data(), lstm_bias.data(), lstm_bias.data(),
+         lstm_h.data(), lstm_c.data(), lstm_buffer, &lstm_parameter);
+  });
+
+  std::cout << "hidden_size=" << hidden_size << " input_size=" << input_size << " seq_len=" << seq_len
+            << " batch=" << batch_size << "\n";
+  std::cout << "Gru : " << gru_us << " us\n";
+  std::cout << "Lstm: " << lstm_us << " us\n";
+  std::cout << "Gru/Lstm: " << gru_us / lstm_us << std::endl;
+  for (auto value : gru_y) {
+    ASSERT_TRUE(std::isfinite(value));
+  }
+}
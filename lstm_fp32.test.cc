@@ -111,3 +111,486 @@ TEST_F(LstmFp32Test, Testcase02) {
   ASSERT_GT(sim_c, 0.99);
 }
 
+TEST_F(LstmFp32Test, Testcase03_StackedBatch) {
+  // Two batch-2 requests stacked along batch into one batch-4 call must give each request the
+  // same y/h/c as running it alone, so a batching layer can gather and scatter freely.
+  const int num_direction = 2;
+  const int hidden_size = 4;
+  const int input_size = 2;
+  const int seq_len = 3;
+  const int request_batch = 2;
+  const int request_num = 2;
+  const int col_align = UP_ROUND(hidden_size, C8NUM);
+  // Packed weights, col-8 major as PackLstmWeight produces: [direction][gate][col_align / 8][deep][8].
+  // With hidden_size 4 there is a single column block, so row * col_align + col addresses it directly;
+  // padded columns stay 0
+  std::vector<float> weight_i(num_direction * 4 * input_size * col_align, 0);
+  std::vector<float> weight_h(num_direction * 4 * hidden_size * col_align, 0);
+  for (int row = 0; row < num_direction * 4 * input_size; row++) {
+    for (int col = 0; col < hidden_size; col++) {
+      weight_i[row * col_align + col] = static_cast<float>((row * 7 + col * 3) % 11 - 5) * 0.1f;
+    }
+  }
+  for (int row = 0; row < num_direction * 4 * hidden_size; row++) {
+    for (int col = 0; col < hidden_size; col++) {
+      weight_h[row * col_align + col] = static_cast<float>((row * 5 + col * 9) % 13 - 6) * 0.08f;
+    }
+  }
+  std::vector<float> input_bias(num_direction * 8 * hidden_size, 0);
+  std::vector<float> state_bias(num_direction * 8 * hidden_size, 0);
+
+  // Per-request data: input [seq][batch][input], states [direction][batch][hidden]
+  std::vector<std::vector<float>> request_x(request_num);
+  std::vector<std::vector<float>> request_h(request_num);
+  std::vector<std::vector<float>> request_c(request_num);
+  for (int r = 0; r < request_num; r++) {
+    for (int i = 0; i < seq_len * request_batch * input_size; i++) {
+      request_x[r].push_back(static_cast<float>((i * 3 + r * 5) % 7 - 3) * 0.5f);
+    }
+    for (int i = 0; i < num_direction * request_batch * hidden_size; i++) {
+      request_h[r].push_back(static_cast<float>((i * 5 + r * 3) % 9 - 4) * 0.2f);
+      request_c[r].push_back(static_cast<float>((i * 7 + r) % 11 - 5) * 0.3f);
+    }
+  }
+
+  auto run_lstm = [&](int batch_size, std::vector<float> *input_x, std::vector<float> *hidden,
+                      std::vector<float> *cell) {
+    std::vector<float> output_y(seq_len * num_direction * batch_size * hidden_size, 0.0);
+    std::vector<std::vector<float>> buffer_storage;
+    buffer_storage.reserve(4);
+    for (int i = 0; i < 4; i++) {
+      buffer_storage.emplace_back(512, 0.0f);
+    }
+    float *buffer[7] = {buffer_storage[0].data(),
+                        buffer_storage[1].data(),
+                        buffer_storage[2].data(),
+                        buffer_storage[3].data(),
+                        nullptr,
+                        nullptr,
+                        nullptr};
+    const int row_align = UP_ROUND(seq_len * batch_size, C12NUM);
+    const int state_row_align = UP_ROUND(batch_size, C12NUM);
+    const LstmParameter lstm_parameter = {{"", 87, 1, 0}, input_size, hidden_size, 0, hidden_size, seq_len,
+                                          batch_size, num_direction * batch_size * hidden_size, true, 0, 0,
+                                          row_align, col_align, state_row_align, col_align, col_align, false};
+    Lstm(output_y.data(), input_x->data(), weight_i.data(), weight_h.data(), input_bias.data(), state_bias.data(),
+         hidden->data(), cell->data(), buffer, &lstm_parameter);
+    return output_y;
+  };
+
+  // Each request on its own
+  std::vector<std::vector<float>> single_y(request_num);
+  std::vector<std::vector<float>> single_h = request_h;
+  std::vector<std::vector<float>> single_c = request_c;
+  for (int r = 0; r < request_num; r++) {
+    single_y[r] = run_lstm(request_batch, &request_x[r], &single_h[r], &single_c[r]);
+  }
+
+  // Gather: stack requests along batch
+  const int stacked_batch = request_num * request_batch;
+  std::vector<float> stacked_x;
+  std::vector<float> stacked_h;
+  std::vector<float> stacked_c;
+  for (int t = 0; t < seq_len; t++) {
+    for (int r = 0; r < request_num; r++) {
+      auto begin = request_x[r].begin() + t * request_batch * input_size;
+      stacked_x.insert(stacked_x.end(), begin, begin + request_batch * input_size);
+    }
+  }
+  for (int d = 0; d < num_direction; d++) {
+    for (int r = 0; r < request_num; r++) {
+      auto h_begin = request_h[r].begin() + d * request_batch * hidden_size;
+      auto c_begin = request_c[r].begin() + d * request_batch * hidden_size;
+      stacked_h.insert(stacked_h.end(), h_begin, h_begin + request_batch * hidden_size);
+      stacked_c.insert(stacked_c.end(), c_begin, c_begin + request_batch * hidden_size);
+    }
+  }
+  std::vector<float> stacked_y = run_lstm(stacked_batch, &stacked_x, &stacked_h, &stacked_c);
+
+  // Scatter back and compare: y is [seq][direction][batch][hidden], h/c are [direction][batch][hidden]
+  const int block = request_batch * hidden_size;
+  for (int r = 0; r < request_num; r++) {
+    std::vector<float> scattered_y;
+    std::vector<float> scattered_h;
+    std::vector<float> scattered_c;
+    for (int t = 0; t < seq_len; t++) {
+      for (int d = 0; d < num_direction; d++) {
+        auto begin = stacked_y.begin() + (t * num_direction + d) * stacked_batch * hidden_size + r * block;
+        scattered_y.insert(scattered_y.end(), begin, begin + block);
+      }
+    }
+    for (int d = 0; d < num_direction; d++) {
+      auto h_begin = stacked_h.begin() + d * stacked_batch * hidden_size + r * block;
+      auto c_begin = stacked_c.begin() + d * stacked_batch * hidden_size + r * block;
+      scattered_h.insert(scattered_h.end(), h_begin, h_begin + block);
+      scattered_c.insert(scattered_c.end(), c_begin, c_begin + block);
+    }
+    std::cout << "request " << r << " output_y :\n";
+    std::for_each(scattered_y.begin(), scattered_y.end(), [](float value) { std::cout << value << " "; });
+    std::cout << std::endl;
+    float sim_y = get_cosine_similarity(scattered_y.data(), single_y[r].data(), scattered_y.size());
+    float sim_h = get_cosine_similarity(scattered_h.data(), single_h[r].data(), scattered_h.size());
+    float sim_c = get_cosine_similarity(scattered_c.data(), single_c[r].data(), scattered_c.size());
+    ASSERT_GT(sim_y, 0.99);
+    ASSERT_GT(sim_h, 0.99);
+    ASSERT_GT(sim_c, 0.99);
+    for (size_t i = 0; i < scattered_y.size(); i++) {
+      ASSERT_NEAR(scattered_y[i], single_y[r][i], 1e-5) << "request " << r << " y index " << i;
+    }
+    for (size_t i = 0; i < scattered_h.size(); i++) {
+      ASSERT_NEAR(scattered_h[i], single_h[r][i], 1e-5) << "request " << r << " h index " << i;
+      ASSERT_NEAR(scattered_c[i], single_c[r][i], 1e-5) << "request " << r << " c index " << i;
+    }
+  }
+}
+
+TEST_F(LstmFp32Test, Testcase04_ProjectionStepwise) {
+  // LSTMP: r_t = W_proj * h_t (project_size <= hidden_size) is fed back as the recurrent state and
+  // emitted as y_t. The scalar LSTMP reference below is the one a fused projection path has to match.
+  // The Lstm kernel here has no projection input, so the stepwise driver (Lstm with seq_len=1 and the
+  // projection GEMM in between) only covers the square case project_size == hidden_size. A rectangular
+  // LSTMP is checked through it by zero-padding: W_proj gets hidden_size - project_size zero columns,
+  // the padded r entries start at 0 and stay 0, so whatever weight_h holds in the padded rows is inert.
+  const int hidden_size = 16;
+  const int input_size = 3;
+  const int seq_len = 4;
+  const int batch_size = 2;
+  const int col_align = UP_ROUND(hidden_size, C8NUM);
+  // Packed weights are col-8 major as PackLstmWeight produces, [gate][col_align / 8][deep][8], gate
+  // order i, o, f, c; packed_index maps (gate, deep row k, column j) into that layout
+  auto packed_index = [&](int g, int deep, int k, int j) {
+    return (g * (col_align / C8NUM) + j / C8NUM) * deep * C8NUM + k * C8NUM + j % C8NUM;
+  };
+  std::vector<float> weight_i(4 * input_size * col_align, 0);
+  for (int g = 0; g < 4; g++) {
+    for (int k = 0; k < input_size; k++) {
+      for (int col = 0; col < hidden_size; col++) {
+        weight_i[packed_index(g, input_size, k, col)] =
+          static_cast<float>(((g * input_size + k) * 7 + col * 3) % 17 - 8) * 0.05f;
+      }
+    }
+  }
+  std::vector<float> input_bias(8 * col_align, 0);
+  std::vector<float> state_bias(8 * col_align, 0);
+  std::vector<float> input_x(seq_len * batch_size * input_size);
+  for (size_t i = 0; i < input_x.size(); i++) {
+    input_x[i] = static_cast<float>(static_cast<int>(i * 3 % 11) - 5) * 0.3f;
+  }
+  std::vector<float> init_c(batch_size * hidden_size);
+  for (int i = 0; i < batch_size * hidden_size; i++) {
+    init_c[i] = static_cast<float>(i % 5 - 2) * 0.2f;
+  }
+
+  struct LstmpData {
+    int project_size;
+    std::vector<float> weight_h;     // [gate][col_align / 8][project_size][8]
+    std::vector<float> weight_proj;  // [hidden][project_size], row-major
+    std::vector<float> init_r;       // [batch][project_size]
+  };
+  auto make_data = [&](int project_size) {
+    LstmpData data;
+    data.project_size = project_size;
+    data.weight_h.assign(4 * project_size * col_align, 0);
+    for (int g = 0; g < 4; g++) {
+      for (int k = 0; k < project_size; k++) {
+        for (int col = 0; col < hidden_size; col++) {
+          data.weight_h[packed_index(g, project_size, k, col)] =
+            static_cast<float>((g * 29 + k * 5 + col * 11) % 19 - 9) * 0.03f;
+        }
+      }
+    }
+    data.weight_proj.resize(hidden_size * project_size);
+    for (int j = 0; j < hidden_size; j++) {
+      for (int p = 0; p < project_size; p++) {
+        data.weight_proj[j * project_size + p] = static_cast<float>((j * 13 + p * 7) % 23 - 11) * 0.04f;
+      }
+    }
+    data.init_r.resize(batch_size * project_size);
+    for (int b = 0; b < batch_size; b++) {
+      for (int p = 0; p < project_size; p++) {
+        data.init_r[b * project_size + p] = static_cast<float>((b * 5 + p) % 7 - 3) * 0.1f;
+      }
+    }
+    return data;
+  };
+
+  // Scalar LSTMP reference, any project_size <= hidden_size
+  auto sigmoid = [](float value) { return 1.0f / (1.0f + std::exp(-value)); };
+  auto lstmp_reference = [&](const LstmpData &data, std::vector<float> *output_y, std::vector<float> *state_r,
+                             std::vector<float> *state_c) {
+    const int project_size = data.project_size;
+    output_y->assign(seq_len * batch_size * project_size, 0);
+    *state_r = data.init_r;
+    *state_c = init_c;
+    for (int t = 0; t < seq_len; t++) {
+      std::vector<float> next_r(batch_size * project_size);
+      for (int b = 0; b < batch_size; b++) {
+        std::vector<float> gate(4 * hidden_size);
+        for (int g = 0; g < 4; g++) {
+          for (int j = 0; j < hidden_size; j++) {
+            float acc = 0;
+            for (int k = 0; k < input_size; k++) {
+              acc += input_x[(t * batch_size + b) * input_size + k] * weight_i[packed_index(g, input_size, k, j)];
+            }
+            for (int k = 0; k < project_size; k++) {
+              acc += (*state_r)[b * project_size + k] * data.weight_h[packed_index(g, project_size, k, j)];
+            }
+            gate[g * hidden_size + j] = acc;
+          }
+        }
+        std::vector<float> hidden(hidden_size);
+        for (int j = 0; j < hidden_size; j++) {
+          float &cell = (*state_c)[b * hidden_size + j];
+          cell = sigmoid(gate[2 * hidden_size + j]) * cell + sigmoid(gate[j]) * std::tanh(gate[3 * hidden_size + j]);
+          hidden[j] = sigmoid(gate[hidden_size + j]) * std::tanh(cell);
+        }
+        for (int p = 0; p < project_size; p++) {
+          float acc = 0;
+          for (int j = 0; j < hidden_size; j++) {
+            acc += hidden[j] * data.weight_proj[j * project_size + p];
+          }
+          next_r[b * project_size + p] = acc;
+        }
+      }
+      *state_r = next_r;
+      std::copy(next_r.begin(), next_r.end(), output_y->begin() + t * batch_size * project_size);
+    }
+  };
+
+  // Lstm step by step with the projection in between; square projection only
+  std::vector<std::vector<float>> buffer_storage;
+  buffer_storage.reserve(4);
+  for (int i = 0; i < 4; i++) {
+    buffer_storage.emplace_back(512, 0.0f);
+  }
+  float *buffer[7] = {buffer_storage[0].data(),
+                      buffer_storage[1].data(),
+                      buffer_storage[2].data(),
+                      buffer_storage[3].data(),
+                      nullptr,
+                      nullptr,
+                      nullptr};
+  const LstmParameter lstm_parameter = {{"", 87, 1, 0}, input_size, hidden_size, 0, hidden_size, 1, batch_size,
+                                        batch_size * hidden_size, false, 0, 0, UP_ROUND(batch_size, C12NUM),
+                                        col_align, UP_ROUND(batch_size, C12NUM), col_align, col_align, false};
+  auto lstm_stepwise = [&](const LstmpData &data, std::vector<float> *output_y, std::vector<float> *state_r,
+                           std::vector<float> *state_c) {
+    ASSERT_EQ(data.project_size, hidden_size) << "the stepwise driver covers the square projection only";
+    output_y->assign(seq_len * batch_size * hidden_size, 0);
+    *state_r = data.init_r;
+    *state_c = init_c;
+    std::vector<float> step_y(batch_size * hidden_size, 0.0);
+    for (int t = 0; t < seq_len; t++) {
+      Lstm(step_y.data(), input_x.data() + t * batch_size * input_size, weight_i.data(), data.weight_h.data(),
+           input_bias.data(), state_bias.data(), state_r->data(), state_c->data(), buffer, &lstm_parameter);
+      for (int b = 0; b < batch_size; b++) {
+        for (int p = 0; p < hidden_size; p++) {
+          float acc = 0;
+          for (int j = 0; j < hidden_size; j++) {
+            acc += step_y[b * hidden_size + j] * data.weight_proj[j * hidden_size + p];
+          }
+          (*output_y)[(t * batch_size + b) * hidden_size + p] = acc;
+        }
+      }
+      std::copy(output_y->begin() + t * batch_size * hidden_size,
+                output_y->begin() + (t + 1) * batch_size * hidden_size, state_r->begin());
+    }
+  };
+
+  // Square: project_size == hidden_size, driver against the reference directly
+  {
+    LstmpData data = make_data(hidden_size);
+    std::vector<float> benchmark_y, benchmark_r, benchmark_c;
+    lstmp_reference(data, &benchmark_y, &benchmark_r, &benchmark_c);
+    std::vector<float> output_y, state_r, state_c;
+    lstm_stepwise(data, &output_y, &state_r, &state_c);
+    std::cout << "output_y (project " << hidden_size << "):\n";
+    std::for_each(output_y.begin(), output_y.end(), [](float value) { std::cout << value << " "; });
+    std::cout << std::endl;
+    for (size_t i = 0; i < output_y.size(); i++) {
+      ASSERT_NEAR(output_y[i], benchmark_y[i], 1e-4) << "square y index " << i;
+    }
+    for (size_t i = 0; i < state_r.size(); i++) {
+      ASSERT_NEAR(state_r[i], benchmark_r[i], 1e-4) << "square r index " << i;
+    }
+    for (size_t i = 0; i < state_c.size(); i++) {
+      ASSERT_NEAR(state_c[i], benchmark_c[i], 1e-4) << "square c index " << i;
+    }
+  }
+
+  // Rectangular: hidden 16 -> project 8, reference against the zero-padded square driver
+  {
+    const int project_size = 8;
+    LstmpData data = make_data(project_size);
+    std::vector<float> benchmark_y, benchmark_r, benchmark_c;
+    lstmp_reference(data, &benchmark_y, &benchmark_r, &benchmark_c);
+
+    LstmpData padded = make_data(hidden_size);  // padded weight_h rows keep their nonzero values
+    for (int g = 0; g < 4; g++) {
+      for (int k = 0; k < project_size; k++) {
+        for (int col = 0; col < hidden_size; col++) {
+          padded.weight_h[packed_index(g, hidden_size, k, col)] = data.weight_h[packed_index(g, project_size, k, col)];
+        }
+      }
+    }
+    std::fill(padded.weight_proj.begin(), padded.weight_proj.end(), 0.0f);
+    std::fill(padded.init_r.begin(), padded.init_r.end(), 0.0f);
+    for (int j = 0; j < hidden_size; j++) {
+      for (int p = 0; p < project_size; p++) {
+        padded.weight_proj[j * hidden_size + p] = data.weight_proj[j * project_size + p];
+      }
+    }
+    for (int b = 0; b < batch_size; b++) {
+      for (int p = 0; p < project_size; p++) {
+        padded.init_r[b * hidden_size + p] = data.init_r[b * project_size + p];
+      }
+    }
+    std::vector<float> output_y, state_r, state_c;
+    lstm_stepwise(padded, &output_y, &state_r, &state_c);
+    for (int row = 0; row < seq_len * batch_size; row++) {
+      for (int p = 0; p < hidden_size; p++) {
+        float expect = p < project_size ? benchmark_y[row * project_size + p] : 0.0f;
+        ASSERT_NEAR(output_y[row * hidden_size + p], expect, 1e-4) << "rect y row " << row << " p " << p;
+      }
+    }
+    for (int b = 0; b < batch_size; b++) {
+      for (int p = 0; p < project_size; p++) {
+        ASSERT_NEAR(state_r[b * hidden_size + p], benchmark_r[b * project_size + p], 1e-4)
+          << "rect r " << b << "," << p;
+      }
+    }
+    for (size_t i = 0; i < state_c.size(); i++) {
+      ASSERT_NEAR(state_c[i], benchmark_c[i], 1e-4) << "rect c index " << i;
+    }
+  }
+}
+
+TEST_F(LstmFp32Test, Testcase05_ReducedPrecisionStorage) {
+  // Weights (and optionally the h/c states) stored as bf16 or fp16 and widened back to fp32 before the
+  // fp32-accumulating Lstm: the result has to stay within the same cosine-similarity threshold as the
+  // fp32 reference, which is the accuracy budget for a half-width storage mode.
+  const int hidden_size = 64;
+  const int input_size = 32;
+  const int seq_len = 8;
+  const int batch_size = 2;
+  const int col_align = UP_ROUND(hidden_size, C8NUM);
+  std::vector<float> weight_i(4 * input_size * col_align, 0);
+  std::vector<float> weight_h(4 * hidden_size * col_align, 0);
+  for (int row = 0; row < 4 * input_size; row++) {
+    for (int col = 0; col < hidden_size; col++) {
+      weight_i[row * col_align + col] = std::sin(static_cast<float>(row * 131 + col * 17)) * 0.2f;
+    }
+  }
+  for (int row = 0; row < 4 * hidden_size; row++) {
+    for (int col = 0; col < hidden_size; col++) {
+      weight_h[row * col_align + col] = std::cos(static_cast<float>(row * 71 + col * 29)) * 0.15f;
+    }
+  }
+  std::vector<float> input_bias(8 * col_align, 0);
+  std::vector<float> state_bias(8 * col_align, 0);
+  std::vector<float> input_x(seq_len * batch_size * input_size);
+  for (size_t i = 0; i < input_x.size(); i++) {
+    input_x[i] = std::sin(static_cast<float>(i) * 0.37f);
+  }
+  std::vector<float> init_h(batch_size * hidden_size);
+  std::vector<float> init_c(batch_size * hidden_size);
+  for (size_t i = 0; i < init_h.size(); i++) {
+    init_h[i] = std::cos(static_cast<float>(i) * 0.21f) * 0.5f;
+    init_c[i] = std::sin(static_cast<float>(i) * 0.13f);
+  }
+
+  // Storage round trips, round-to-nearest-even on the fp32 bit pattern
+  auto to_bf16 = [](float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bits += 0x7fff + ((bits >> 16) & 1);
+    bits &= 0xffff0000;
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+  };
+  auto to_fp16 = [](float value) {
+    const float min_normal = 6.103515625e-05f;  // 2^-14
+    if (std::fabs(value) < min_normal) {
+      return std::nearbyint(value * 16777216.0f) / 16777216.0f;  // fp16 subnormal step is 2^-24
+    }
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bits += 0xfff + ((bits >> 13) & 1);
+    bits &= 0xffffe000;
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+  };
+
+  std::vector<std::vector<float>> buffer_storage;
+  buffer_storage.reserve(4);
+  for (int i = 0; i < 4; i++) {
+    buffer_storage.emplace_back(4 * UP_ROUND(seq_len * batch_size, C12NUM) * col_align, 0.0f);
+  }
+  float *buffer[7] = {buffer_storage[0].data(),
+                      buffer_storage[1].data(),
+                      buffer_storage[2].data(),
+                      buffer_storage[3].data(),
+                      nullptr,
+                      nullptr,
+                      nullptr};
+  const LstmParameter lstm_parameter = {{"", 87, 1, 0}, input_size, hidden_size, 0, hidden_size, seq_len,
+                                        batch_size, batch_size * hidden_size, false, 0, 0,
+                                        UP_ROUND(seq_len * batch_size, C12NUM), col_align,
+                                        UP_ROUND(batch_size, C12NUM), col_align, col_align, false};
+  const LstmParameter step_parameter = {{"", 87, 1, 0}, input_size, hidden_size, 0, hidden_size, 1, batch_size,
+                                        batch_size * hidden_size, false, 0, 0, UP_ROUND(batch_size, C12NUM),
+                                        col_align, UP_ROUND(batch_size, C12NUM), col_align, col_align, false};
+  const int output_y_shape = seq_len * batch_size * hidden_size;
+  const int state_shape = batch_size * hidden_size;
+
+  // fp32 reference
+  std::vector<float> benchmark_y(output_y_shape, 0.0);
+  std::vector<float> benchmark_h = init_h;
+  std::vector<float> benchmark_c = init_c;
+  Lstm(benchmark_y.data(), input_x.data(), weight_i.data(), weight_h.data(), input_bias.data(), state_bias.data(),
+       benchmark_h.data(), benchmark_c.data(), buffer, &lstm_parameter);
+
+  auto run_case = [&](const char *name, const std::function<float(float)> &round_trip, bool round_states) {
+    std::vector<float> stored_weight_i(weight_i.size());
+    std::vector<float> stored_weight_h(weight_h.size());
+    std::transform(weight_i.begin(), weight_i.end(), stored_weight_i.begin(), round_trip);
+    std::transform(weight_h.begin(), weight_h.end(), stored_weight_h.begin(), round_trip);
+    std::vector<float> output_y(output_y_shape, 0.0);
+    std::vector<float> hidden = init_h;
+    std::vector<float> cell = init_c;
+    if (round_states) {
+      // States are stored between steps, so run one step at a time and round h/c in between
+      for (int t = 0; t < seq_len; t++) {
+        std::transform(hidden.begin(), hidden.end(), hidden.begin(), round_trip);
+        std::transform(cell.begin(), cell.end(), cell.begin(), round_trip);
+        Lstm(output_y.data() + t * state_shape, input_x.data() + t * batch_size * input_size,
+             stored_weight_i.data(), stored_weight_h.data(), input_bias.data(), state_bias.data(), hidden.data(),
+             cell.data(), buffer, &step_parameter);
+      }
+    } else {
+      Lstm(output_y.data(), input_x.data(), stored_weight_i.data(), stored_weight_h.data(), input_bias.data(),
+           state_bias.data(), hidden.data(), cell.data(), buffer, &lstm_parameter);
+    }
+    float sim_y = get_cosine_similarity(output_y.data(), benchmark_y.data(), output_y_shape);
+    float sim_h = get_cosine_similarity(hidden.data(), benchmark_h.data(), state_shape);
+    float sim_c = get_cosine_similarity(cell.data(), benchmark_c.data(), state_shape);
+    float max_diff = 0;
+    for (int i = 0; i < output_y_shape; i++) {
+      max_diff = std::max(max_diff, std::fabs(output_y[i] - benchmark_y[i]));
+    }
+    std::cout << name << (round_states ? " weights+states" : " weights") << ": sim_y=" << sim_y
+              << " sim_h=" << sim_h << " sim_c=" << sim_c << " max_abs_diff_y=" << max_diff << std::endl;
+    ASSERT_GT(sim_y, 0.99);
+    ASSERT_GT(sim_h, 0.99);
+    ASSERT_GT(sim_c, 0.99);
+  };
+
+  std::cout << "weight bytes fp32=" << (weight_i.size() + weight_h.size()) * sizeof(float)
+            << " half=" << (weight_i.size() + weight_h.size()) * sizeof(uint16_t) << std::endl;
+  run_case("bf16", to_bf16, false);
+  run_case("bf16", to_bf16, true);
+  run_case("fp16", to_fp16, false);
+  run_case("fp16", to_fp16, true);
+}